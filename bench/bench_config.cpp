@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include "ConfigLoader.h"
+#include "LogsJson.h"
+#include "SchedulerClass.h"
+
+/*
+Benchmark of the scheduler startup on a generated config with many processes:
+    json DOM       the old loader: the file through a stringstream into a json DOM, the process
+                   list copied out of it three times (validation, duplicate check, loadConfig)
+    ConfigLoader   the streaming loader, one pass without a DOM
+    workload       the same config compiled to a binary workload, mapped and checksummed
+    Scheduler      the whole constructor, loading plus building the process pool, from the json
+                   config and from the compiled workload
+    bench_config [processes]
+*/
+
+static double timed(const std::function<void()>& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+static void report(const std::string& name, size_t processes, double seconds)
+{
+    std::cout << name << ": " << processes << " processes in " << seconds * 1e3 << " ms, "
+              << seconds * 1e9 / processes << " ns/process" << std::endl;
+}
+
+static void writeConfig(const std::filesystem::path& path, size_t processes)
+{
+    std::ofstream out(path);
+    out << "{\n    \"scheduler_config\": {\n        \"time_quantum\": 4,\n"
+        << "        \"aging_threshold\": 5,\n        \"max_priority\": 140,\n"
+        << "        \"context_switch_time\": 1\n    },\n    \"processes\": [\n";
+    for (size_t i = 0; i < processes; i++)
+    {
+        out << "        {\n            \"pid\": " << i + 1 << ",\n            \"priority\": "
+            << i % 140 + 1 << ",\n            \"burst_time\": " << i % 97 + 1
+            << ",\n            \"io_bound\": " << (i % 3 == 0 ? "true" : "false")
+            << ",\n            \"io_interval\": " << i % 7 << "\n        }"
+            << (i + 1 < processes ? ",\n" : "\n");
+    }
+    out << "    ]\n}\n";
+}
+
+static std::vector<ProcessConfig> domProcesses(const json& config)
+{
+    std::vector<ProcessConfig> processes;
+    for (const auto& i : config["processes"])
+    {
+        ProcessConfig proc;
+        proc.pid = i["pid"];
+        proc.priority = i["priority"];
+        proc.burst = i["burst_time"];
+        proc.io_bound = i["io_bound"];
+        proc.io_interval = i["io_interval"];
+        processes.push_back(proc);
+    }
+    return processes;
+}
+
+int main(int argc, char** argv)
+{
+    size_t processes = argc > 1 ? std::stoull(argv[1]) : 1'000'000;
+
+    auto dir = std::filesystem::temp_directory_path() / "scheduler_bench";
+    std::filesystem::create_directories(dir);
+    setLogDirectory(dir);
+
+    auto config = dir / "bench_config.json";
+    writeConfig(config, processes);
+    std::cout << "config: " << std::filesystem::file_size(config) / (1 << 20) << " MiB"
+              << std::endl;
+
+    size_t loaded = 0;
+    double dom_s = timed(
+        [&]()
+        {
+            std::ifstream file(config);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            json data = json::parse(buffer.str());
+
+            std::vector<ProcessConfig> checked = domProcesses(data);
+            std::set<int> pids;
+            for (const auto& p : checked)
+                pids.insert(p.pid);
+            loaded = domProcesses(data).size();
+        });
+    report("json DOM", loaded, dom_s);
+
+    double sax_s =
+        timed([&]() { loaded = ConfigLoader(config.string()).getProcessConfig().size(); });
+    report("ConfigLoader", loaded, sax_s);
+
+    auto workload = dir / "bench_config.workload";
+    ConfigLoader(config.string()).compileWorkload(workload);
+    double map_s = timed([&]() { loaded = ConfigLoader(workload.string()).getProcessCount(); });
+    report("workload", loaded, map_s);
+
+    double sched_s = timed([&]() { Scheduler scheduler("bench_startup", config.string()); });
+    report("Scheduler (json)", processes, sched_s);
+
+    double sched_map_s = timed([&]() { Scheduler scheduler("bench_startup", workload.string()); });
+    report("Scheduler (workload)", processes, sched_map_s);
+
+    std::cout << "ConfigLoader speedup over json DOM: " << dom_s / sax_s << "x" << std::endl;
+    std::cout << "workload speedup over json DOM: " << dom_s / map_s << "x" << std::endl;
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
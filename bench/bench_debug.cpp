@@ -0,0 +1,146 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "DebugLog.h"
+#include "DebugSink.h"
+
+/*
+Benchmark of the debug helpers with debugging off at runtime, on a loop shaped like the dispatch
+loop (a little work and one EXEC message per iteration):
+    baseline       no debug call at all
+    eager format   std::format before the call, the old Scheduler::debug(EXEC, std::format(...))
+    lazy           message built in a callable, only the runtime level test is left
+    compiled out   category outside the compile-time mask, nothing is left
+and with debugging on, every message written to a file:
+    endl           a stream flushed per line, like std::cout << ... << std::endl
+    sink           the DebugSink ring buffer, drained by its background thread
+    bench_debug [iterations] [debug_lines]
+*/
+
+static constexpr int BENCH_EXEC = 1 << 0;
+
+static volatile int debug_level = 0;  // runtime level, volatile so it is read every iteration
+static volatile uint64_t sink = 0;
+
+static double timed(uint64_t iterations, const std::function<uint64_t(uint64_t)>& loop)
+{
+    auto start = std::chrono::steady_clock::now();
+    sink = loop(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() * 1e9 / iterations;
+}
+
+// work of a dispatch, pid/remaining/time bookkeeping
+static inline uint64_t step(uint64_t i, uint64_t acc)
+{
+    return acc * 31 + (i % 1000) + (acc >> 7);
+}
+
+static std::string execMessage(uint64_t i, uint64_t acc)
+{
+    return std::format(
+        "[EXEC] PID: {} ran for {} -> remaining time: {}", i % 1000 + 1, 4, acc % 100);
+}
+
+static uint64_t baselineLoop(uint64_t n)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+        acc = step(i, acc);
+    return acc;
+}
+
+static uint64_t eagerLoop(uint64_t n)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        acc = step(i, acc);
+        std::string msg = execMessage(i, acc);
+        debugLog<BENCH_EXEC>(debug_level, msg);
+    }
+    return acc;
+}
+
+// Compiled is the compile-time mask, 0 compiles the message out.
+template <int Compiled>
+static uint64_t lazyLoop(uint64_t n)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        acc = step(i, acc);
+        debugLog<BENCH_EXEC, Compiled>(debug_level, [&]() { return execMessage(i, acc); });
+    }
+    return acc;
+}
+
+static uint64_t endlLoop(uint64_t n, std::ofstream& out)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        acc = step(i, acc);
+        out << execMessage(i, acc) << std::endl;
+    }
+    return acc;
+}
+
+static uint64_t sinkLoop(uint64_t n, DebugSink& sink)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        acc = step(i, acc);
+        debugLog<BENCH_EXEC>(BENCH_EXEC, &sink, [&]() { return execMessage(i, acc); });
+    }
+    sink.flush();
+    return acc;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t iterations = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    uint64_t debug_lines = argc > 2 ? std::stoull(argv[2]) : 200'000;
+
+    timed(iterations, baselineLoop);  // warm up
+    double baseline = timed(iterations, baselineLoop);
+    double eager = timed(iterations, eagerLoop);
+    double lazy = timed(iterations, lazyLoop<BENCH_EXEC>);
+    double compiled_out = timed(iterations, lazyLoop<0>);
+
+    std::cout << "iterations: " << iterations << ", debugging off at runtime" << std::endl;
+    std::cout << "baseline:     " << baseline << " ns/iteration" << std::endl;
+    std::cout << "eager format: " << eager << " ns/iteration" << std::endl;
+    std::cout << "lazy:         " << lazy << " ns/iteration" << std::endl;
+    std::cout << "compiled out: " << compiled_out << " ns/iteration" << std::endl;
+
+    auto log_path = std::filesystem::temp_directory_path() / "bench_debug.log";
+
+    std::ofstream out(log_path, std::ios::trunc);
+    double endl_ns = timed(debug_lines, [&](uint64_t n) { return endlLoop(n, out); });
+    out.close();
+
+    int fd = ::open(log_path.c_str(), O_WRONLY | O_TRUNC);
+    double sink_ns;
+    {
+        DebugSink sink(DebugSink::Mode::DRAIN, DebugSink::DEFAULT_CAPACITY, fd);
+        sink_ns = timed(debug_lines, [&](uint64_t n) { return sinkLoop(n, sink); });
+    }
+    ::close(fd);
+    std::filesystem::remove(log_path);
+
+    std::cout << "lines: " << debug_lines << ", debugging on" << std::endl;
+    std::cout << "endl:         " << endl_ns << " ns/line" << std::endl;
+    std::cout << "sink:         " << sink_ns << " ns/line" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "ProcessTable.h"
+#include "SimdKernels.h"
+
+/*
+Microbenchmark of the aging and IO countdown kernels, every supported ISA against the scalar path.
+    bench_kernels [processes] [rounds]
+*/
+
+const int BENCH_AGING = 5;
+const int BENCH_TIME = 4;
+
+static std::vector<PCB> makePool(size_t processes)
+{
+    std::vector<PCB> pool;
+    pool.reserve(processes);
+    for (size_t i = 0; i < processes; i++)
+    {
+        int pid = static_cast<int>(i + 1);
+        pool.emplace_back(pid, pid % 140 + 1, 100, pid % 2 == 0, 50, BENCH_AGING, BENCH_TIME);
+
+        // a third of the processes waiting on IO, the rest ready
+        if (i % 3 == 0)
+        {
+            pool.back().setState(ProcessState::WAITING_IO);
+            pool.back().setIOTime(pid % 50 + 1);
+        }
+    }
+    return pool;
+}
+
+int main(int argc, char** argv)
+{
+    size_t processes = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    int rounds = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    std::cout << "processes: " << processes << ", rounds: " << rounds
+              << ", detected: " << kernelIsaName(detectKernelIsa()) << std::endl;
+
+    const KernelIsa best = detectKernelIsa();
+    double scalar_ns = 0;
+
+    for (int isa = static_cast<int>(KernelIsa::SCALAR); isa <= static_cast<int>(best); isa++)
+    {
+        setKernelIsa(static_cast<KernelIsa>(isa));
+
+        std::vector<PCB> pool = makePool(processes);
+        ProcessTable table(pool);
+        size_t changed = 0;
+
+        double ns = 0;
+        for (int r = 0; r < rounds; r++)
+        {
+            // put the finished IO back, so every round has the same amount of work
+            if (r % 16 == 15)
+            {
+                table.gather();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            changed += table.ageReady(r % 7 + 1, static_cast<size_t>(r) % processes).size();
+            changed += table.advanceIO(r % 5 + 1).size();
+            auto end = std::chrono::steady_clock::now();
+
+            ns += std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        double per_row = ns / (static_cast<double>(rounds) * processes);
+        if (isa == static_cast<int>(KernelIsa::SCALAR))
+            scalar_ns = ns;
+
+        std::cout << kernelIsaName(static_cast<KernelIsa>(isa)) << ": " << ns / 1e6 << " ms, "
+                  << per_row << " ns/process/round, speedup " << scalar_ns / ns
+                  << "x (changed " << changed << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+
+#include "BinaryTrace.h"
+#include "LogsJson.h"
+#include "MmapTraceWriter.h"
+#include "NdjsonWriter.h"
+
+/*
+Benchmark of the event log writers: the mmap trace writer against the buffered ofstream writers,
+the NDJSON writer (on a tenth of the events) and the read-modify-rewrite appendToJSON_array from
+LogsJson.cpp (on far fewer events, it is O(N^2)).
+    bench_trace [events] [json_array_events]
+*/
+
+static TraceRecord makeRecord(uint64_t i)
+{
+    TraceRecord r{};
+    r.timestamp = static_cast<int64_t>(i * 4);
+    r.pid = static_cast<int32_t>(i % 1000 + 1);
+    r.waiting_time = static_cast<int32_t>(i % 20);
+    r.remaining_time = static_cast<int32_t>(1000 - i % 1000);
+    r.cpu_used = 4;
+    r.io_interval = 8;
+    r.prio = static_cast<uint16_t>(i % 140 + 1);
+    r.event = 0;
+    r.flags = 0;
+    return r;
+}
+
+static void report(const std::string& name,
+                   uint64_t events,
+                   double seconds,
+                   const std::filesystem::path& file)
+{
+    auto bytes = std::filesystem::file_size(file);
+    std::cout << name << ": " << events << " events in " << seconds * 1e3 << " ms, "
+              << seconds * 1e9 / events << " ns/event, " << bytes / (1 << 20) << " MiB" << std::endl;
+}
+
+static double timed(const std::function<void()>& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t events = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    uint64_t array_events = argc > 2 ? std::stoull(argv[2]) : 500;
+    uint64_t ndjson_events = std::max<uint64_t>(1, events / 10);
+
+    setLogDirectory(std::filesystem::temp_directory_path() / "scheduler_bench");
+
+    double mmap_s = timed(
+        [&]()
+        {
+            MmapTraceWriter writer;
+            writer.open(makeTracePath("bench_mmap"));
+            for (uint64_t i = 0; i < events; i++)
+                writer.write(makeRecord(i));
+            writer.close();
+        });
+    report("mmap trace", events, mmap_s, makeTracePath("bench_mmap"));
+
+    double trace_s = timed(
+        [&]()
+        {
+            TraceWriter writer;
+            writer.open(makeTracePath("bench_stream"));
+            for (uint64_t i = 0; i < events; i++)
+                writer.write(makeRecord(i));
+            writer.close();
+        });
+    report("ofstream trace", events, trace_s, makeTracePath("bench_stream"));
+
+    double ndjson_s = timed(
+        [&]()
+        {
+            NdjsonWriter writer;
+            writer.open(makeLogPath("bench.ndjson"));
+            for (uint64_t i = 0; i < ndjson_events; i++)
+                writer.write(traceRecordToJson(makeRecord(i)));
+            writer.close();
+        });
+    report("ofstream ndjson", ndjson_events, ndjson_s, makeLogPath("bench.ndjson"));
+
+    double array_s = timed(
+        [&]()
+        {
+            createJSON("bench_array");
+            for (uint64_t i = 0; i < array_events; i++)
+                appendToJSON_array("bench_array", traceRecordToJson(makeRecord(i)));
+        });
+    report("appendToJSON_array", array_events, array_s, makeLogPath("bench_array"));
+
+    std::cout << "mmap speedup over ofstream trace: " << trace_s / mmap_s << "x" << std::endl;
+
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / "scheduler_bench");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+#include "PCB.h"
+
+/*
+AgingEngine
+    Lazy, timestamp based aging of the processes in the ready queues.
+
+    Instead of adding the time delta to every waiting process after each dispatch, the engine keeps
+    an aging clock (the sum of all deltas so far) and remembers the clock value when a process
+    entered the ready queue. The waited time is then (clock - enqueued_at), and is only written back
+    to the PCB (through PCB::ageProcess) when the process leaves the queue or is promoted.
+
+    A deadline heap holds the clock value at which each process reaches the aging threshold, so
+    every advance only touches the processes that are actually promoted.
+*/
+class AgingEngine
+{
+   public:
+    AgingEngine(std::vector<PCB>& process_pool);
+
+    void reset();
+
+    // Process enters / leaves a ready queue.
+    void track(size_t idx);
+    void untrack(size_t idx);
+
+    // Advance the aging clock with delta, for every tracked process except 'skip'.
+    // Returns the promoted processes in index order, their PCB priority is already updated.
+    const std::vector<size_t>& advance(int delta, size_t skip);
+
+    // Query methods
+    bool isTracked(size_t idx) const;
+    long long getClock() const;
+    size_t pendingDeadlines() const;
+
+   private:
+    struct Deadline
+    {
+        long long at;         // aging clock value where the threshold is reached
+        size_t idx;           // process index
+        uint32_t generation;  // stale if the process was requeued since
+
+        bool operator>(const Deadline& other) const
+        {
+            return at > other.at;
+        }
+    };
+
+    void schedule(size_t idx);
+    void compact();
+
+    std::vector<PCB>& process_pool;
+
+    long long clock = 0;
+    size_t tracked_count = 0;
+    std::vector<long long> enqueued_at;  // aging clock when the process entered the queue
+    std::vector<uint32_t> generation;    // bumped on every track/untrack
+    std::vector<bool> tracked;
+
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> deadlines;
+    std::vector<size_t> promoted;
+};
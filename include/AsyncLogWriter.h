@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "BinaryTrace.h"
+#include "SpscQueue.h"
+
+struct AsyncLogStats
+{
+    uint64_t records = 0;           // records handed to the writer thread
+    uint64_t batches = 0;           // batches handed over (full ones and flushes)
+    uint64_t flushes = 0;           // flush() calls
+    uint64_t producer_waits = 0;    // times the producer found no free batch
+    uint64_t producer_wait_ns = 0;  // total time spent waiting for one
+};
+
+/*
+AsyncLogWriter
+    Moves the event log I/O off the simulation thread. The producer fills fixed-size batches of
+    TraceRecords; a full batch is handed to the writer thread through a lock-free SPSC queue and
+    comes back through a second one once it is written. With the default two batches that is
+    double buffering: the simulation fills one batch while the other is serialised and written.
+
+    When no batch is free the producer has to wait, those waits are the backpressure statistics.
+    flush() hands over the current batch and blocks until everything before it is written and the
+    sink is flushed.
+*/
+class AsyncLogWriter
+{
+   public:
+    using BatchSink = std::function<void(const TraceRecord* records, size_t count)>;
+    using FlushSink = std::function<void()>;
+
+    static constexpr size_t DEFAULT_BATCH_RECORDS = 4096;
+    static constexpr size_t DEFAULT_BATCHES = 2;
+    static constexpr size_t MAX_BATCHES = 16;
+
+    AsyncLogWriter(BatchSink sink,
+                   FlushSink flush_sink,
+                   size_t batch_records = DEFAULT_BATCH_RECORDS,
+                   size_t batch_count = DEFAULT_BATCHES);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // producer side, one thread only
+    void write(const TraceRecord& record);
+    void flush();
+    void close();
+
+    AsyncLogStats getStats() const;
+
+   private:
+    static constexpr size_t NO_BATCH = std::numeric_limits<size_t>::max();
+
+    struct Batch
+    {
+        std::vector<TraceRecord> records;
+        bool flush = false;
+    };
+
+    void acquire();
+    void submit(bool flush_after);
+    void writerLoop();
+
+    BatchSink sink;
+    FlushSink flush_sink;
+    size_t batch_records;
+
+    std::vector<Batch> batches;
+    SpscQueue<size_t, MAX_BATCHES> filled;        // producer -> writer thread
+    SpscQueue<size_t, MAX_BATCHES> free_batches;  // writer thread -> producer
+    size_t current = NO_BATCH;
+
+    uint64_t submitted = 0;
+    std::atomic<uint64_t> written{0};  // batches done by the writer thread
+
+    AsyncLogStats stats;
+    std::thread writer;
+};
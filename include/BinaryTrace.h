@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "PCB.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/*
+BinaryTrace
+    Compact binary trace of the scheduler events, an alternative to the NDJSON event log.
+
+    File layout (little endian, as written by the host):
+        TraceHeader   32 bytes, magic "SCHTRACE", format version, record size and record count
+        TraceRecord   32 bytes per event, fixed size, no strings
+
+    The header count is rewritten on every flush, so the file is complete after each flush.
+    Readers skip any bytes past the records they know (record_size > sizeof(TraceRecord)), so
+    newer versions can append fields. convertTraceToNdjson() turns a trace back into the NDJSON
+    event log layout.
+*/
+
+enum class TraceEvent : uint8_t
+{
+    RUNNING = 0,
+    IO_WAIT = 1,
+    FINISHED = 2
+};
+
+struct TraceHeader
+{
+    char magic[8];          // "SCHTRACE"
+    uint32_t version;       // TRACE_VERSION
+    uint32_t record_size;   // sizeof(TraceRecord) when written
+    uint64_t record_count;  // records after the header
+    uint64_t reserved;
+};
+
+struct TraceRecord
+{
+    int64_t timestamp;       // scheduler time of the event
+    int32_t pid;
+    int32_t waiting_time;
+    int32_t remaining_time;
+    int32_t cpu_used;
+    int32_t io_interval;
+    uint16_t prio;
+    uint8_t event;  // TraceEvent
+    uint8_t flags;  // bits 0-1 ProcessState, bit 2 io bound
+};
+
+static_assert(sizeof(TraceHeader) == 32, "TraceHeader must be 32 bytes");
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must be 32 bytes");
+
+constexpr char TRACE_MAGIC[8] = {'S', 'C', 'H', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+TraceRecord makeTraceRecord(const PCB& p, TraceEvent event, long long timestamp);
+ProcessState traceState(const TraceRecord& record);
+bool traceIOBound(const TraceRecord& record);
+
+// same keys and values as the NDJSON event log
+json traceRecordToJson(const TraceRecord& record);
+
+// Streams a trace file into an NDJSON file, returns the number of records converted.
+// Throws on a missing file, a bad magic or an unsupported version.
+size_t convertTraceToNdjson(const std::filesystem::path& trace, const std::filesystem::path& out);
+
+// Reads every record of a trace file. Same errors as convertTraceToNdjson.
+std::vector<TraceRecord> readTrace(const std::filesystem::path& trace);
+
+class TraceWriter
+{
+   public:
+    static constexpr size_t DEFAULT_BUFFER_RECORDS = 32768;  // 1 MiB
+
+    TraceWriter(size_t buffer_records = DEFAULT_BUFFER_RECORDS);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    // Spill to the file every max_records records, 0 keeps the default.
+    void setCap(size_t max_records);
+
+    // truncates the file and writes an empty header
+    bool open(const std::filesystem::path& path);
+    void write(const TraceRecord& record);
+    void flush();
+    void close();
+
+    // Query methods
+    bool isOpen() const;
+    uint64_t getWrittenRecords() const;
+    size_t getSpills() const;
+
+   private:
+    void writeHeader();
+
+    std::ofstream out;
+    std::vector<TraceRecord> buffer;
+    size_t buffer_records;
+    uint64_t flushed_records = 0;
+    size_t spills = 0;
+};
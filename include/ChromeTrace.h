@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/*
+ChromeTraceWriter
+    Streams the simulated timeline as Chrome trace-event JSON, for chrome://tracing or
+    ui.perfetto.dev. One simulated time unit is one microsecond in the viewer.
+
+    Tracks:
+        CPU <n>   one complete ("X") slice per quantum executed, plus the context switches
+        IO <n>    one async slice per IO wait, keyed by pid, so overlapping waits stack in rows
+
+    Uses the JSON array format, written through a fixed-size buffer, so memory stays bounded for
+    any number of events. The closing bracket is written on close(), the viewers also load a file
+    cut short without it.
+*/
+class ChromeTraceWriter
+{
+   public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;  // 1 MiB
+    static constexpr int TRACE_PID = 1;                     // the scheduler, a single process
+    static constexpr int IO_TRACK_BASE = 1000;              // IO tracks after the CPU tracks
+
+    ChromeTraceWriter(size_t buffer_size = DEFAULT_BUFFER_SIZE);
+    ~ChromeTraceWriter();
+
+    ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+    // truncates the file and names the tracks
+    bool open(const std::filesystem::path& path, int cpus = 1, int io_devices = 1);
+    void cpuSlice(int cpu, int pid, int prio, long long ts, long long dur);
+    void contextSwitch(int cpu, long long ts, long long dur);
+    void ioBegin(int device, int pid, long long ts);
+    void ioEnd(int device, int pid, long long ts);
+    void flush();
+    void close();  // writes the closing bracket
+
+    // Query methods
+    bool isOpen() const;
+    size_t getWrittenEvents() const;
+    size_t getBufferedBytes() const;
+
+   private:
+    void trackName(int tid, const std::string& name);
+    void append(const std::string& event);
+
+    std::ofstream out;
+    std::string buffer;
+    size_t buffer_size;
+    size_t written_events = 0;
+};
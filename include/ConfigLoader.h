@@ -1,7 +1,10 @@
 #pragma once
+#include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "Workload.h"
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -11,6 +14,29 @@ static constexpr int DEFAULT_AGING_THRESHOLD = 5;
 static constexpr int DEFAULT_MAX_PRIORITY = 3;
 static constexpr int DEFAULT_CONTEXT_SWITCH_TIME = 1;
 
+// upper bound for max_priority, levels are tracked in a 64 * 64 bit PriorityBitmap (level 0 unused).
+static constexpr int MAX_PRIORITY_LEVELS = 4095;
+
+/* LogPolicy struct
+    Which scheduler events reach the event log, optional "log_policy" object in scheduler_config:
+        "events"           event types to keep, any of "RUNNING", "IO_WAIT", "FINISHED"
+        "pids"             only log these processes, empty logs every process
+        "sample_every"     keep 1 in N of the events that pass the filters above
+        "transitions_only" drop an event of the same type as the last one logged for that process
+*/
+static constexpr unsigned LOG_EVENT_RUNNING = 1 << 0;  // bit (1 << TraceEvent)
+static constexpr unsigned LOG_EVENT_IO_WAIT = 1 << 1;
+static constexpr unsigned LOG_EVENT_FINISHED = 1 << 2;
+static constexpr unsigned LOG_EVENT_ALL = LOG_EVENT_RUNNING | LOG_EVENT_IO_WAIT | LOG_EVENT_FINISHED;
+
+struct LogPolicy
+{
+    unsigned event_mask = LOG_EVENT_ALL;
+    std::vector<int> pids;
+    int sample_every = 1;
+    bool transitions_only = false;
+};
+
 /* ScheduleConfig struct
     Values can be provided for specific implementation. If not provided, will default to pre-set
    values.
@@ -22,6 +48,7 @@ struct SchedulerConfig
     int aging_threshold;
     int time_quantum;
     int context_switch_time;
+    LogPolicy log_policy;
 };
 
 // Process config struct
@@ -35,21 +62,66 @@ struct ProcessConfig
     int io_interval;
 };
 
+inline ProcessConfig workloadProcess(const WorkloadRecord& r)
+{
+    return {r.pid, r.priority, r.burst, r.io_bound != 0, r.io_interval};
+}
+
+/* ConfigLoader
+    Loads and validates the config in a single streaming (SAX) pass over the file, no json DOM is
+    built: every value is checked as it is read and each process goes straight into the process
+    list. The scheduler values and the process list can come in any order in the file.
+
+    A file ending in .workload is a compiled workload (Workload.h), it is memory mapped and the
+    processes are read in place, without parsing.
+*/
 class ConfigLoader
 {
    public:
     ConfigLoader(const std::string& config_file);
 
-    std::vector<ProcessConfig> getProcessConfig() const;
+    // for a compiled workload the list is built from the mapping on the first call,
+    // forEachProcess reads the mapping directly.
+    const std::vector<ProcessConfig>& getProcessConfig() const;
     const SchedulerConfig& getSchedulerConfig() const;
+    size_t getProcessCount() const;
+    bool isCompiledWorkload() const;
+
+    template <typename Func>
+    void forEachProcess(Func&& func) const;
+
+    // write the loaded config as a compiled workload, returns false if the file can't be written
+    bool compileWorkload(const std::filesystem::path& out) const;
 
    private:
-    json config_data;
+    friend class ConfigSaxHandler;
+
     std::string config_file;
     SchedulerConfig sched_conf;
+    mutable std::vector<ProcessConfig> processes;  // filled lazily for a compiled workload
+    std::optional<MappedWorkload> workload;
+    bool has_scheduler_config = false;
+    bool has_processes = false;
+    bool pids_ascending = true;  // common case, no duplicate check needed
 
     void validate();
     void loadFromFile();
-    void validateSchedulerConfig();
+    void loadWorkload(const std::filesystem::path& path);
+    void validateSchedulerConfig() const;
     void validateProcessConfig() const;
-};
\ No newline at end of file
+};
+
+template <typename Func>
+void ConfigLoader::forEachProcess(Func&& func) const
+{
+    if (!workload)
+    {
+        for (const auto& p : processes)
+            func(p);
+        return;
+    }
+
+    const WorkloadRecord* records = workload->getRecords();
+    for (size_t i = 0; i < workload->size(); i++)
+        func(workloadProcess(records[i]));
+}
\ No newline at end of file
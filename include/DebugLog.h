@@ -0,0 +1,63 @@
+#pragma once
+#include <concepts>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "DebugSink.h"
+
+/*
+DebugLog
+    Debug output with a compile-time and a runtime category mask.
+
+    Categories outside SCHEDULER_DEBUG_MASK are compiled out: the call, the message and its
+    formatting are removed entirely (build with `make DEBUG_MASK=0` for none). Compiled-in
+    categories are checked against the runtime level first, and a message given as a callable is
+    only built when its category is enabled. The message goes to a DebugSink when one is given,
+    otherwise to std::cout with a flush per line.
+*/
+
+#ifndef SCHEDULER_DEBUG_MASK
+#define SCHEDULER_DEBUG_MASK 0xFFFF
+#endif
+
+static constexpr int COMPILED_DEBUG_MASK = SCHEDULER_DEBUG_MASK;
+
+template <int Category, int Compiled = COMPILED_DEBUG_MASK, typename Msg>
+inline void debugLog(int level, DebugSink* sink, Msg&& msg)
+{
+    if constexpr ((Category & Compiled) != 0)
+    {
+        if (level & Category)
+        {
+            if (sink == nullptr)
+            {
+                if constexpr (std::invocable<Msg>)
+                    std::cout << msg() << std::endl;
+                else
+                    std::cout << msg << std::endl;
+            }
+            else if constexpr (std::invocable<Msg>)
+            {
+                sink->write(msg());
+            }
+            else if constexpr (std::convertible_to<Msg, std::string_view>)
+            {
+                sink->write(msg);
+            }
+            else
+            {
+                std::ostringstream oss;
+                oss << msg;
+                sink->write(oss.str());
+            }
+        }
+    }
+}
+
+template <int Category, int Compiled = COMPILED_DEBUG_MASK, typename Msg>
+inline void debugLog(int level, Msg&& msg)
+{
+    debugLog<Category, Compiled>(level, nullptr, std::forward<Msg>(msg));
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <unistd.h>
+
+#include <atomic>
+#include <csignal>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct DebugSinkStats
+{
+    uint64_t lines = 0;          // lines written to the sink
+    uint64_t dropped_bytes = 0;  // overwritten before they were output (DUMP_ON_EXIT only)
+    uint64_t producer_waits = 0; // times a writer waited for the drain thread (DRAIN only)
+};
+
+/*
+DebugSink
+    In-memory ring buffer for the debug output, instead of std::cout with a flush per line.
+
+    DRAIN         a background thread writes the ring to the file descriptor in large chunks. A
+                  writer only waits when the ring is full, nothing is lost.
+    DUMP_ON_EXIT  flight recorder: the ring keeps the newest output, older lines are overwritten,
+                  and it is written out on destruction or flush().
+
+    In both modes whatever is still buffered is written out if the process crashes (SIGSEGV,
+    SIGABRT, SIGBUS, SIGFPE, SIGILL) while the sink is alive, every live sink is dumped. The crash
+    handlers are installed by the first live sink and chain to the handlers that were installed
+    before (a sanitizer, the host application), which are restored when the last sink is
+    destroyed. POSIX only.
+*/
+class DebugSink
+{
+   public:
+    enum class Mode
+    {
+        DRAIN,
+        DUMP_ON_EXIT
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;  // 1 MiB
+
+    DebugSink(Mode mode = Mode::DRAIN, size_t capacity = DEFAULT_CAPACITY, int fd = STDOUT_FILENO);
+    ~DebugSink();
+
+    DebugSink(const DebugSink&) = delete;
+    DebugSink& operator=(const DebugSink&) = delete;
+
+    // appends line + '\n', lines longer than the ring are cut
+    void write(std::string_view line);
+    // DRAIN: blocks until everything written so far is output. DUMP_ON_EXIT: outputs the ring.
+    void flush();
+
+    // Query methods
+    Mode getMode() const;
+    size_t getCapacity() const;
+    size_t getBufferedBytes() const;
+    DebugSinkStats getStats() const;
+
+   private:
+    void drainLoop();
+    void output(uint64_t from, uint64_t to);  // ring positions [from, to) to fd
+    static void crashHandler(int sig, siginfo_t* info, void* context);
+    static void installCrashHandlers();  // first live sink
+    static void restoreCrashHandlers();  // last live sink
+    void linkCrashSink();
+    void unlinkCrashSink();
+
+    Mode mode;
+    int fd;
+    std::vector<char> ring;
+
+    // absolute positions, the ring index is position % capacity. Changed under the lock, atomic
+    // so the crash handler can read them without it.
+    std::atomic<uint64_t> head{0};  // next byte to write
+    std::atomic<uint64_t> tail{0};  // next byte to output
+    bool stopping = false;
+    DebugSinkStats stats;
+
+    mutable std::mutex lock;
+    std::condition_variable data_ready;  // writer -> drain thread
+    std::condition_variable space_free;  // drain thread -> writers, and flush()
+    std::thread drainer;
+
+    // live sinks dumped by the crash handler, newest first
+    static std::atomic<DebugSink*> crash_sinks;
+    std::atomic<DebugSink*> next_crash_sink{nullptr};
+};
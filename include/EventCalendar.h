@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+enum class EventType
+{
+    ARRIVAL = 0,          // process enters the system
+    IO_COMPLETION = 1,    // process done with IO, back to its ready queue
+    QUANTUM_EXPIRY = 2,   // running process used its slice (or blocked/finished)
+    AGING_PROMOTION = 3,  // waiting process reached the aging threshold
+};
+
+struct Event
+{
+    long long time;  // simulated time the event happens at
+    uint64_t seq;    // insertion order, breaks ties between events at the same time
+    EventType type;
+    size_t idx;  // process index
+};
+
+/*
+EventCalendar
+    Global event calendar for the scheduler: a min-heap of typed events ordered by (time, seq).
+    Events at the same time are handled in the order they were scheduled.
+*/
+class EventCalendar
+{
+   public:
+    void schedule(long long time, EventType type, size_t idx);
+    Event pop();
+    const Event& peek() const;
+    void clear();
+
+    // Query methods
+    bool empty() const;
+    size_t size() const;
+    long long nextTime() const;
+    uint64_t getScheduledCount() const;
+
+   private:
+    struct Later
+    {
+        bool operator()(const Event& a, const Event& b) const
+        {
+            return a.time != b.time ? a.time > b.time : a.seq > b.seq;
+        }
+    };
+
+    std::priority_queue<Event, std::vector<Event>, Later> events;
+    uint64_t next_seq = 0;
+};
@@ -1,9 +1,24 @@
 #pragma once
-#include <deque>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "PCB.h"
 
+/*
+IOManager
+    Processes waiting for IO, kept in an indexed min-heap of absolute completion times on the IO
+    clock (the total time the IO device has been advanced with). The heap position of every process
+    is stored per process index, so the next completion is O(1), popping the completed ones is
+    O(log n) each and cancel is O(log n), instead of touching every waiting process per call.
+
+    The PCB's io remaining time is set when the IO starts and reset when it completes, in between
+    use getRemainingIOTime().
+
+    Membership is the heap position, so contains(idx) is O(1). containsPID() maps the pid to its
+    process index first.
+*/
 class IOManager
 {
    public:
@@ -13,13 +28,17 @@ class IOManager
     void updateIO();
     void processIO(int timeslice);
     void handleIOqueue();
+    bool cancel(size_t idx);
     const std::vector<size_t>& getFinishedProcesses() const;
-    const std::deque<size_t>& getQueue() const;
+    std::vector<size_t> getQueue() const;
 
     // Query methods
     bool isEmpty() const;
     size_t size() const;
+    bool contains(size_t idx) const;
     bool containsPID(int pid) const;
+    int getRemainingIOTime(size_t idx) const;
+    long long getIOClock() const;
 
     // Utility methods
     void clear();
@@ -28,7 +47,33 @@ class IOManager
     void printQueue() const;
 
    private:
+    static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+    struct Entry
+    {
+        long long done_at;  // IO clock value where the IO completes
+        long long set_at;   // IO clock value when done_at was set
+        uint64_t seq;       // enqueue order
+        size_t idx;         // process index
+    };
+
+    // indexed heap helpers
+    bool before(const Entry& a, const Entry& b) const;
+    void heapPush(const Entry& e);
+    Entry heapPop();
+    void heapErase(size_t pos);
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+    void place(size_t pos, const Entry& e);
+
     std::vector<PCB>& process_pool;
-    std::deque<size_t> IO_queue;
+    long long io_clock = 0;
+    uint64_t next_seq = 0;
+
+    std::vector<Entry> heap;
+    std::vector<size_t> heap_pos;  // per process index, NPOS if not waiting on IO
+    std::vector<size_t> pending;   // enqueued since the last updateIO
     std::vector<size_t> finished_IO;
+    std::unordered_map<int, size_t> pid_index;  // pid -> process index, filled on enqueue
+    std::vector<Entry> completed;  // scratch for processIO
 };
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/*
+LatencyHistogram
+    Log-bucketed (HDR style) histogram of non-negative times. Values below 2^SUB_BUCKET_BITS get a
+    bucket each, above that every power of two is split into 2^(SUB_BUCKET_BITS - 1) buckets, so a
+    percentile is within 1/64 (~1.6%) of the recorded value and the bucket count grows with the
+    log of the largest value, not with the number of values.
+
+    Histograms with the same layout merge by adding bucket counts. toJson() writes the summary
+    and only the non-empty buckets, as [lowest value, count] pairs; fromJson() reads that back.
+*/
+class LatencyHistogram
+{
+   public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+
+    void record(long long value, uint64_t count = 1);
+    // takes back a recorded value, min and max are not narrowed again
+    void remove(long long value, uint64_t count = 1);
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    // smallest recorded-equivalent value with at least percentile % of the values at or below it
+    long long percentile(double percentile) const;
+
+    // Query methods
+    uint64_t getCount() const;
+    long long getMin() const;
+    long long getMax() const;
+    double getMean() const;
+    size_t getBucketCount() const;  // allocated buckets
+
+    json toJson() const;
+    static LatencyHistogram fromJson(const json& j);
+
+    // bucket layout
+    static size_t bucketIndex(long long value);
+    static long long bucketLowest(size_t index);
+    static long long bucketHighest(size_t index);
+
+   private:
+    std::vector<uint64_t> counts;  // grows to the highest bucket used
+    uint64_t total = 0;
+    long long min = 0;
+    long long max = 0;
+    long double sum = 0;
+};
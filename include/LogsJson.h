@@ -7,7 +7,9 @@ using json = nlohmann::json;
 void setLogDirectory(const std::filesystem::path& dir);
 void ensureLogDirExists();
 std::filesystem::path makeLogPath(const std::string& filename);
+std::filesystem::path makeTracePath(const std::string& filename);
 std::string extensionJSON(const std::string& filename);
+std::string extensionNDJSON(const std::string& filename);
 void appendToJSON_array(const std::string& filename, const json& entry);
 void appendToJSON_object(const std::string& filename, const json& entry);
 void createJSON(const std::string& filename);
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
+#include <cstdint>
+#include <map>
+#include <optional>
 #include <vector>
 
+#include "LatencyHistogram.h"
 #include "PCB.h"
+#include "WindowedCounters.h"
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -18,25 +23,77 @@ struct ProcessMetrics
     int completion_time;  // time worked on : time from arrival
 };
 
+struct LatencyPercentiles
+{
+    long long p50 = 0;
+    long long p90 = 0;
+    long long p99 = 0;
+    long long p999 = 0;  // p99.9
+};
+
+// response, waiting and turnaround time distributions of a group of processes
+struct LatencyHistograms
+{
+    LatencyHistogram response;
+    LatencyHistogram waiting;
+    LatencyHistogram turnaround;
+
+    void record(const ProcessMetrics& pm);
+    void remove(const ProcessMetrics& pm);
+    void merge(const LatencyHistograms& other);
+    json toJson() const;
+};
+
 struct SystemMetrics
 {
     double avg_turnaround_time;
     double avg_waiting_time;
     double avg_response_time;
-    double cpu_utilization;  // (total cpu time / total time) * 100 (for procent)
-    double throughput;       // total processes / total time
-    int total_time;          // total time spent on all processes
-    int total_processes;     // amount of processes
+    double cpu_utilization;   // (total cpu time / total time) * 100 (for procent)
+    double throughput;        // total processes / total time
+    int total_time;           // total time spent on all processes
+    int total_processes;      // amount of processes
+    int completed_processes;  // processes completed so far
+    // percentiles over the completed processes
+    LatencyPercentiles response_percentiles;
+    LatencyPercentiles waiting_percentiles;
+    LatencyPercentiles turnaround_percentiles;
     std::vector<ProcessMetrics> per_process;
 };
 
+/* Metrics
+    Incremental metrics. The scheduler reports every completion (recordCompletion) and every
+    executed slice (recordExecution), and the running sums are updated right away, so calculate()
+    and snapshot() are O(1) at any simulated time. per_process has one slot per pool index, filled
+    when that process completes.
+
+    Completions also go into latency histograms, overall and per initial priority, for the tail
+    percentiles (LatencyHistogram.h). Their cost depends on the bucket count, not the pool size.
+    With enableWindows() they also feed a fixed ring of per-window counters (WindowedCounters.h).
+*/
 class Metrics
 {
    public:
     Metrics(std::vector<PCB>& process_pool);
 
-    // calculate metrics from process pool
-    SystemMetrics calculate(int total_time);
+    // clear the sums and slots, call when the pool order is final (before a run)
+    void reset();
+
+    // hooks, called by the scheduler
+    void recordCompletion(size_t idx);  // next to PCB::setCompletionTime
+    void recordExecution(long long start, int cpu_time);
+
+    // throughput/utilization per window of simulated time, call before the run
+    void enableWindows(long long window_ticks = WindowedCounters::DEFAULT_WINDOW_TICKS,
+                       size_t capacity = WindowedCounters::DEFAULT_WINDOWS);
+    const std::optional<WindowedCounters>& getWindows() const;
+    void writeWindowsToFile(const std::string& name, long long end_time) const;
+
+    // metrics over the whole pool at the end of a run (averages over every process)
+    const SystemMetrics& calculate(int total_time);
+
+    // live view at current_time, averages over the completed processes, no per_process copy
+    SystemMetrics snapshot(int current_time) const;
 
     // to json format
     // write to file
@@ -45,14 +102,31 @@ class Metrics
 
     // process metrics
     ProcessMetrics getProcessMetrics(int pid) const;
+    const LatencyHistograms& getHistograms() const;
+    const std::map<int, LatencyHistograms>& getPriorityHistograms() const;  // by initial priority
     double getAvgTurnaroundTime() const;
     double getCpuUtilization() const;
 
    private:
     const std::vector<PCB>& process_pool;
-    SystemMetrics cached_metrics;
+    SystemMetrics cached_metrics;  // per_process holds the slots
     bool metrics_calculated;
 
+    // running sums over the completed processes, 64-bit for large pools
+    std::vector<uint8_t> completed;  // per pool index
+    int completed_count = 0;
+    long long total_turnaround_time = 0;
+    long long total_waiting_time = 0;
+    long long total_response_time = 0;
+    long long total_cpu_time = 0;
+    long long executed_cpu_time = 0;  // every slice run so far, finished or not
+
+    LatencyHistograms histograms;
+    std::map<int, LatencyHistograms> priority_histograms;  // only the levels that were used
+    std::optional<WindowedCounters> windows;
+
+    void fillPercentiles(SystemMetrics& metrics) const;
+
     // private helper methods
     ProcessMetrics calculateProcessMetrics(const PCB& proc) const;
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "BinaryTrace.h"
+
+/*
+MmapTraceWriter
+    Binary trace writer (same file format as TraceWriter) that writes the records straight into a
+    memory mapping of the file, so writing an event is a memcpy and issues no syscall.
+
+    The file grows in preallocated segments: ftruncate to the next segment boundary, map that
+    segment, fill it, unmap and map the next one. On close the file is truncated back to the used
+    length and the header gets the final record count. POSIX only.
+*/
+class MmapTraceWriter
+{
+   public:
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = 16 << 20;  // 16 MiB
+
+    MmapTraceWriter(size_t segment_size = DEFAULT_SEGMENT_SIZE);
+    ~MmapTraceWriter();
+
+    MmapTraceWriter(const MmapTraceWriter&) = delete;
+    MmapTraceWriter& operator=(const MmapTraceWriter&) = delete;
+
+    // truncates the file and maps the first segment
+    bool open(const std::filesystem::path& path);
+    void write(const TraceRecord& record);
+    void flush();  // updates the header count
+    void close();  // unmaps and truncates to the used length
+
+    // Query methods
+    bool isOpen() const;
+    uint64_t getWrittenRecords() const;
+    size_t getSegments() const;
+
+   private:
+    void mapSegment(size_t index);
+    void unmap();
+    void writeHeader();
+
+    int fd = -1;
+    char* window = nullptr;  // mapping of the current segment
+    size_t segment_size;
+    size_t segment_index = 0;
+    size_t window_pos = 0;  // write offset inside the current segment
+    uint64_t records = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "PriorityBitmap.h"
+
+/*
+MultiLevelQueue
+    The ready queues for all priority levels (1 = highest), plus a bitmap of the non-empty levels.
+    Every push/pop/remove keeps the bitmap in sync, so finding the next level to dispatch from does
+    not depend on the number of levels.
+
+    The queues are intrusive doubly-linked lists: the prev/next links live in a vector indexed by
+    the process index, beside the process pool. A process can be in at most one level at a time,
+    which gives O(1) contains and O(1) remove, while each level keeps its FIFO order.
+*/
+class MultiLevelQueue
+{
+   public:
+    static constexpr size_t NIL = std::numeric_limits<size_t>::max();
+    static constexpr int NOT_QUEUED = -1;
+
+    void resize(int max_priority);
+    void reserve(size_t processes);
+    void clear();
+
+    void push(int level, size_t idx);
+    size_t pop(int level);
+    bool remove(int level, size_t idx);
+
+    // Query methods
+    bool contains(int level, size_t idx) const;
+    bool empty(int level) const;
+    bool empty() const;
+    size_t size(int level) const;
+    size_t front(int level) const;
+    int levelOf(size_t idx) const;
+    int highestLevel() const;
+    int nextLevel(int level) const;
+    int maxPriority() const;
+    std::vector<size_t> toVector(int level) const;
+
+   private:
+    struct Link
+    {
+        size_t prev = NIL;
+        size_t next = NIL;
+        int level = NOT_QUEUED;
+    };
+
+    struct Level
+    {
+        size_t head = NIL;
+        size_t tail = NIL;
+        size_t count = 0;
+    };
+
+    void unlink(size_t idx);
+
+    std::vector<Link> links;    // one per process index
+    std::vector<Level> levels;  // index 0 is unused, levels start at 1
+    PriorityBitmap non_empty;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/*
+NdjsonWriter
+    Streaming event log sink. Keeps the file open and writes one compact JSON object per line
+    (newline delimited JSON) through an in-memory buffer, so writing N events costs O(N) instead
+    of re-reading and rewriting the whole file per event.
+
+    The buffer is written out (spilled) when it reaches its cap, in events or bytes, and on
+    flush(). Only whole lines are ever written, so the file is a valid NDJSON file after every
+    flush, and the memory used for the log stays at the cap no matter how long the run is.
+*/
+class NdjsonWriter
+{
+   public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;  // 1 MiB
+
+    NdjsonWriter(size_t buffer_size = DEFAULT_BUFFER_SIZE);
+    ~NdjsonWriter();
+
+    NdjsonWriter(const NdjsonWriter&) = delete;
+    NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+    // Spill when either cap is reached, 0 turns that cap off. Both off keeps the default buffer.
+    void setCap(size_t max_events, size_t max_bytes);
+
+    // truncates the file
+    bool open(const std::filesystem::path& path);
+    void write(const json& entry);
+    void flush();
+    void close();
+
+    // Query methods
+    bool isOpen() const;
+    size_t getWrittenEvents() const;
+    size_t getBufferedBytes() const;
+    size_t getSpills() const;
+    size_t getPeakBufferedBytes() const;
+
+   private:
+    std::ofstream out;
+    std::string buffer;
+    size_t buffer_size;
+    size_t max_events = 0;
+    size_t buffered_events = 0;
+    size_t written_events = 0;
+    size_t spills = 0;
+    size_t peak_buffered_bytes = 0;
+};
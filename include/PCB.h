@@ -31,6 +31,7 @@ class PCB
     int getPid() const;
     int getPriority() const;
     int getOldPriority() const;
+    int getInitialPriority() const;
     int getBurstTime() const;
     int getCpuUsed() const;
     int getIOInterval() const;
@@ -41,15 +42,21 @@ class PCB
     int getTotalIOTime() const;
     int getTotalCpuUsedTime() const;
     int getFirstResponseTime() const;
+    int getAgingLimit() const;
     bool isIOBound() const;
     bool isFirstResponse() const;
 
     ProcessState getState() const;
     std::string getStringState() const;
+    static const char* stateToString(ProcessState state);
 
     // Setters
     void setState(ProcessState state);
     void setPriority(int prio);
+    void promoteTo(int prio);  // like an aging promotion, the current priority becomes the old one
+    void setRemainingTime(int time);
+    void setWaitingTime(int time);
+    void setTotalIOTime(int time);
     void recordFirstResponse(int time);
     void setIOTime(int io_remainingtime);
     void setCompletionTime(int time);
@@ -67,6 +74,7 @@ class PCB
     int pid;                  // process id
     int prio;                 // current priority
     int old_prio;             // original prio
+    int initial_prio;         // prio from the config, before any aging
     int burst_time;           // burst time
     int remaining_time;       // remaining time after burst
     int waiting_time;         // time a process has waited to be executed (for aging)
@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+PriorityBitmap
+    One bit per priority level, set while that level has queued processes.
+    The bits are split into 64-bit words, plus a summary word with one bit per non-empty word.
+    The highest priority (lowest level number) that has work is then two count-trailing-zeros,
+    no matter how many levels there are. Supports up to 64 * 64 = 4096 levels.
+*/
+class PriorityBitmap
+{
+   public:
+    static constexpr int WORD_BITS = 64;
+    static constexpr int MAX_LEVELS = WORD_BITS * WORD_BITS;
+    static constexpr int NO_LEVEL = -1;
+
+    void resize(int levels)
+    {
+        if (levels > MAX_LEVELS)
+        {
+            throw std::runtime_error("PriorityBitmap supports at most " +
+                                     std::to_string(MAX_LEVELS) + " levels");
+        }
+        words.assign((levels + WORD_BITS - 1) / WORD_BITS, 0);
+        summary = 0;
+    }
+
+    void set(int level)
+    {
+        size_t w = level / WORD_BITS;
+        words[w] |= bit(level % WORD_BITS);
+        summary |= bit(w);
+    }
+
+    void clear(int level)
+    {
+        size_t w = level / WORD_BITS;
+        words[w] &= ~bit(level % WORD_BITS);
+        if (words[w] == 0)
+        {
+            summary &= ~bit(w);
+        }
+    }
+
+    bool test(int level) const
+    {
+        return (words[level / WORD_BITS] >> (level % WORD_BITS)) & 1;
+    }
+
+    bool any() const
+    {
+        return summary != 0;
+    }
+
+    void reset()
+    {
+        std::fill(words.begin(), words.end(), 0);
+        summary = 0;
+    }
+
+    // lowest set level, or NO_LEVEL if every level is empty.
+    int findFirst() const
+    {
+        if (summary == 0)
+            return NO_LEVEL;
+
+        int w = std::countr_zero(summary);
+        return w * WORD_BITS + std::countr_zero(words[w]);
+    }
+
+    // lowest set level above 'level', or NO_LEVEL if there is none.
+    int findNext(int level) const
+    {
+        int w = (level + 1) / WORD_BITS;
+        int b = (level + 1) % WORD_BITS;
+        if (w >= static_cast<int>(words.size()))
+            return NO_LEVEL;
+
+        uint64_t rest = words[w] & (~uint64_t{0} << b);
+        if (rest != 0)
+            return w * WORD_BITS + std::countr_zero(rest);
+
+        // remaining words, through the summary
+        uint64_t later = (w + 1 < WORD_BITS) ? summary & (~uint64_t{0} << (w + 1)) : 0;
+        if (later == 0)
+            return NO_LEVEL;
+
+        int next = std::countr_zero(later);
+        return next * WORD_BITS + std::countr_zero(words[next]);
+    }
+
+   private:
+    static constexpr uint64_t bit(size_t pos)
+    {
+        return uint64_t{1} << pos;
+    }
+
+    std::vector<uint64_t> words;
+    uint64_t summary = 0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+
+#include "PCB.h"
+
+/*
+ProcessTable
+    Struct-of-arrays copy of the hot PCB fields: remaining time, priority, waiting time, io
+    remaining and state each live in their own contiguous column, so a pass that only needs two or
+    three of them streams through memory instead of striding over whole PCBs.
+
+    The process pool stays the owner of every PCB. gather() copies the pool into the columns,
+    scatter() writes the columns back through the PCB accessors, and pcb(idx) is the PCB view of
+    one row (scattered first), so code and tests that work on PCBs keep working.
+
+    Not used by the Scheduler: its aging and IO are event driven (AgingEngine, IOManager) and
+    only touch the processes an event is due for, so there is no per tick pass over the pool for
+    the columns to speed up. The table and its kernels are exercised by the tests and
+    bench/bench_kernels.cpp.
+*/
+class ProcessTable
+{
+   public:
+    ProcessTable(std::vector<PCB>& process_pool);
+
+    // pool -> columns
+    void gather();
+    void gather(size_t idx);
+
+    // columns -> pool
+    void scatter();
+    void scatter(size_t idx);
+
+    // PCB view of a row, the row is written back first.
+    PCB& pcb(size_t idx);
+
+    // Bulk passes over the columns (SimdKernels), same rules as PCB::ageProcess and the IO
+    // countdown.
+    // Ages every READY row except 'skip', returns the promoted rows in index order.
+    const std::vector<size_t>& ageReady(int delta, size_t skip);
+    // Counts down every WAITING_IO row, returns the rows whose IO reached 0 in index order.
+    const std::vector<size_t>& advanceIO(int delta);
+
+    size_t size() const;
+
+    // Columns
+    std::vector<int> remaining_time;
+    std::vector<int> prio;
+    std::vector<int> waiting_time;
+    std::vector<int> io_remaining;
+    std::vector<ProcessState> state;
+
+    // also needed by the passes, aging_limit is never written back
+    std::vector<int> aging_limit;
+    std::vector<int> total_io_time;
+
+   private:
+    std::vector<PCB>& process_pool;
+    std::vector<size_t> changed;  // scratch for the bulk passes
+};
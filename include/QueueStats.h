@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+// counters of one ready queue level
+struct LevelQueueStats
+{
+    uint64_t enqueues = 0;
+    uint64_t dequeues = 0;    // dispatched from this level
+    uint64_t promotions = 0;  // moved out of this level by aging
+    size_t depth = 0;
+    size_t max_depth = 0;
+    long double depth_area = 0;  // depth integrated over time, up to last_change
+    long long last_change = 0;
+    LatencyHistogram wait;  // time in the level, until dispatch or promotion
+};
+
+/*
+QueueStats
+    Instrumentation of the ready queue levels, fed by the scheduler's pushReady / popReady /
+    removeReady. Every update is O(1): the counters, the depth and its time integral (for the
+    time-weighted average depth) and one wait time recorded into the level's histogram. The
+    enqueue time of every queued process is kept by pool index.
+*/
+class QueueStats
+{
+   public:
+    QueueStats(int max_priority, size_t processes);
+
+    void onEnqueue(int level, size_t idx, long long now);
+    void onDequeue(int level, size_t idx, long long now);
+    void onPromotion(int level, size_t idx, long long now);  // removed from level by aging
+
+    // Query methods
+    int getMaxPriority() const;
+    const LevelQueueStats& getLevel(int level) const;
+    double getAverageDepth(int level, long long now) const;  // time-weighted over [0, now]
+
+    // levels that had any process queued
+    json toJson(long long now) const;
+    void writeToFile(const std::string& name, long long now) const;
+
+   private:
+    void leave(int level, size_t idx, long long now);
+    static void setDepth(LevelQueueStats& stats, size_t depth, long long now);
+
+    std::vector<LevelQueueStats> levels;  // by level, 0 unused
+    std::vector<long long> enqueued_at;   // by pool index
+};
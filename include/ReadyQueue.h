@@ -11,6 +11,7 @@ class ReadyQueue
    public:
     bool empty() const;
     bool full() const;
+    size_t size() const;
     T pop();
     void push(T element);
     void clear();
@@ -50,6 +51,12 @@ bool ReadyQueue<T, N>::full() const
     return count == N;
 }
 
+template <typename T, size_t N>
+size_t ReadyQueue<T, N>::size() const
+{
+    return count;
+}
+
 template <typename T, size_t N>
 T ReadyQueue<T, N>::pop()
 {
@@ -170,7 +177,7 @@ std::vector<T> ReadyQueue<T, N>::toVector() const
     for (size_t c = 0; c < count; c++)
     {
         vec.push_back(data[i]);
-        i = (i % 1) % N;
+        i = (i + 1) % N;
     }
     return vec;
-}
\ No newline at end of file
+}
@@ -4,19 +4,36 @@
 #include <string>
 #include <vector>
 
+#include "AgingEngine.h"
+#include "AsyncLogWriter.h"
+#include "BinaryTrace.h"
+#include "ChromeTrace.h"
 #include "ConfigLoader.h"
+#include "DebugLog.h"
+#include "EventCalendar.h"
 #include "IOManager.h"
 #include "LogsJson.h"
 #include "Metrics.h"
+#include "MmapTraceWriter.h"
+#include "MultiLevelQueue.h"
+#include "NdjsonWriter.h"
 #include "PCB.h"
-#include "ReadyQueue.h"
-
-static constexpr int MAX_PROCESS_SIZE = 100;
+#include "QueueStats.h"
 
 class Scheduler
 {
    public:
-    Scheduler(std::string logs_name, std::string config_file);
+    // Event log format, NDJSON or the compact binary trace (BinaryTrace.h)
+    enum class LogFormat
+    {
+        NDJSON,      // <logs_name>.ndjson
+        BINARY,      // <logs_name>.trace
+        BINARY_MMAP  // <logs_name>.trace, written through a memory mapping
+    };
+
+    Scheduler(std::string logs_name,
+              std::string config_file,
+              LogFormat log_format = LogFormat::NDJSON);
 
     // Debug logger
     enum DebugLevel
@@ -37,16 +54,54 @@ class Scheduler
     bool isDebugEnabled(DebugLevel level) const;
     int getDebugLevel() const;
 
+    // Send the debug output to an in-memory ring buffer (DebugSink.h) instead of std::cout,
+    // output to fd.
+    void enableDebugSink(DebugSink::Mode mode = DebugSink::Mode::DRAIN,
+                         size_t capacity = DebugSink::DEFAULT_CAPACITY,
+                         int fd = STDOUT_FILENO);
+    std::optional<DebugSinkStats> getDebugSinkStats() const;
+
     // Queue handler
-    void updateQueuesAfterAging(PCB* p, int& time_slice);
+    void updateQueuesAfterAging(size_t idx, int time_slice);
 
     // Logging
-    void logEvent(PCB* p);
+    void logEvent(size_t idx);  // current event of the process at pool index idx
     void flushLogs();
 
+    // Filter and sample the events before they are logged, set from the config by loadConfig().
+    void setLogPolicy(const LogPolicy& policy);
+    const LogPolicy& getLogPolicy() const;
+
+    // Cap the memory used for buffered events, in events and/or bytes (0 = no cap on that one).
+    // The log is spilled to its file whenever the cap is reached. Call before run().
+    void setLogMemoryCap(size_t max_events, size_t max_bytes = 0);
+    size_t getLogSpills() const;
+
+    // Write the event log on a background thread, call before run().
+    void enableAsyncLogging(size_t batch_records = AsyncLogWriter::DEFAULT_BATCH_RECORDS,
+                            size_t batch_count = AsyncLogWriter::DEFAULT_BATCHES);
+    std::optional<AsyncLogStats> getAsyncLogStats() const;
+
+    // Stream the dispatches and IO waits to <logs_name>_timeline.json as Chrome trace-event
+    // JSON (ChromeTrace.h), call before run(). The file is completed when the scheduler is
+    // destroyed.
+    void enableChromeTrace();
+
+    // O(1) metrics of the run so far, averages over the completed processes.
+    SystemMetrics getMetricsSnapshot() const;
+
+    // Utilization and completions per window of simulated time, written to
+    // <logs_name>_windows.json next to the metrics. Call before run().
+    void enableWindowedMetrics(long long window_ticks = WindowedCounters::DEFAULT_WINDOW_TICKS,
+                               size_t windows = WindowedCounters::DEFAULT_WINDOWS);
+
+    // Per level enqueue / dequeue / promotion counts, depth and wait times of the ready queues,
+    // written to <logs_name>_queues.json next to the metrics. Call before run().
+    void enableQueueStats();
+    const std::optional<QueueStats>& getQueueStats() const;
+
     // Scheduling + Queues setup.
     void priorityScheduling();
-    bool cleanUpQueues(int& currentTime, int& lastTime);
     void roundRobin();
 
     // load config
@@ -60,51 +115,74 @@ class Scheduler
    private:
     // Helper functions to debug
 
-    // Debug helper for lambdas
-    template <typename Func>
-    auto debug(DebugLevel category, Func&& func) const -> decltype(func(), void())
+    // Debug helper, msg is a value or a callable that builds it (only called when enabled).
+    // Categories outside SCHEDULER_DEBUG_MASK are compiled out (DebugLog.h).
+    template <DebugLevel Category, typename Msg>
+    void debug(Msg&& msg) const
     {
-        if (debug_level & category)
-        {
-            std::cout << func() << std::endl;
-        }
-    }
-
-    // Debug helper for direct values
-    template <typename T>
-    auto debug(DebugLevel category, T&& msg) const -> decltype(std::cout << msg, void())
-    {
-        if (debug_level & category)
-        {
-            std::cout << std::forward<T>(msg) << std::endl;
-        }
+        DebugSink* sink = debugSink ? &*debugSink : nullptr;
+        debugLog<Category>(debug_level, sink, std::forward<Msg>(msg));
     }
 
     // Default debug-level set to NONE
     int debug_level = NONE;
+    mutable std::optional<DebugSink> debugSink;  // std::cout when not enabled, written by debug()
 
     // Helper methods
     PCB& getProcessByPID(int pid);
+    void writeRecords(const TraceRecord* records, size_t count);
+    void resetLogFilter();
+
+    // Event engine
+    void handleEvent(const Event& ev);
+    void dispatchNext();
+    bool advanceToNextIOCompletion();
+    void onArrival(size_t idx);
+    void onIOCompletion(size_t idx);
+    void onQuantumExpiry(size_t idx);
+    void onAgingPromotion(size_t idx);
+
+    // Ready queue helpers, keep the aging engine in sync with the queues.
+    void pushReady(int level, size_t idx);
+    size_t popReady(int level);
+    void removeReady(int level, size_t idx);
+
     size_t pidToIndex(int pid) const;
     int indexToPid(size_t idx) const;
 
     // hold the loaded processes
     std::vector<PCB> process_pool;
 
-    int currentTime;
+    int currentTime = 0;
+    int lastTime;          // time of the last handled event
+    int dispatch_delta;    // time between the last event and the running dispatch
+    int dispatch_elapsed;  // time the running dispatch executed for
+    EventCalendar calendar;
+    size_t unfinished_processes = 0;  // processes with remaining time left
     std::optional<PCB> lastProcess;
 
-    std::vector<ReadyQueue<size_t, MAX_PROCESS_SIZE>> readyQueue;
+    MultiLevelQueue readyQueue;
     std::optional<IOManager> IO_Processes;  // for lazy/delayed initialization
+    std::optional<AgingEngine> aging;       // for lazy/delayed initialization
     std::optional<Metrics> metrics;         // for lazy/delayed initialization
+    std::optional<QueueStats> queueStats;   // off unless enableQueueStats()
 
     std::string logs_name;
-    std::vector<json> eventLog;  // store json objects for logging
+    LogFormat log_format;
+    NdjsonWriter eventLog;  // streams the events to <logs_name>.ndjson
+    TraceWriter traceLog;   // or to <logs_name>.trace
+    MmapTraceWriter mmapLog;
+    std::optional<AsyncLogWriter> asyncLog;  // after the writers, its thread is joined first
+    ChromeTraceWriter timeline;              // off unless enableChromeTrace()
+
+    LogPolicy log_policy;
+    std::vector<uint8_t> log_event_masks;  // per pool index, event mask or 0 if not allowlisted
+    std::vector<uint8_t> log_last_event;   // per pool index, for transitions_only
+    uint64_t log_sample_count = 0;
 
     std::string config_file;
     ConfigLoader loader;
     SchedulerConfig sched_conf;
-    std::vector<ProcessConfig> proc_conf;
 
     int time_quantum_sched;
     int aging_threshold_sched;
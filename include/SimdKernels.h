@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+
+#include "PCB.h"
+
+/*
+SimdKernels
+    Vectorised versions of the two bulk passes over the ProcessTable columns, with a scalar
+    fallback. The implementation is picked at runtime from the CPU features (AVX2, then SSE2 on
+    x86, else scalar), and can be forced with setKernelIsa() for tests and benchmarks.
+
+    Both kernels write the indices of the rows they changed to 'out' in index order, and return how
+    many there are. 'out' must have room for n indices.
+*/
+enum class KernelIsa
+{
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+KernelIsa detectKernelIsa();
+KernelIsa getKernelIsa();
+bool setKernelIsa(KernelIsa isa);  // false if the CPU doesn't support it
+const char* kernelIsaName(KernelIsa isa);
+
+// Ages every READY row except 'skip': waiting += delta, and promotes (prio--, waiting = 0) the ones
+// that reach their aging limit with prio > 1. Same rules as PCB::ageProcess.
+size_t ageKernel(int* waiting,
+                 int* prio,
+                 const ProcessState* state,
+                 const int* aging_limit,
+                 size_t n,
+                 int delta,
+                 size_t skip,
+                 size_t* out);
+
+// Counts down every WAITING_IO row by delta (clamped at 0), books the passed time in total_io, and
+// resets the rows that finish (io = 0, waiting = 0, READY). Same rules as IOManager::processIO.
+size_t ioCountdownKernel(int* io_remaining,
+                         int* total_io,
+                         int* waiting,
+                         ProcessState* state,
+                         size_t n,
+                         int delta,
+                         size_t* out);
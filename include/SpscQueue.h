@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*
+SpscQueue
+    Lock-free bounded ring for exactly one producer thread and one consumer thread.
+    The producer only writes tail, the consumer only writes head, each with release ordering, so
+    an element is fully written before the other side can see it.
+
+    waitNotEmpty() / waitNotFull() block on the index with C++20 atomic wait instead of spinning.
+*/
+template <typename T, size_t N>
+
+class SpscQueue
+{
+   public:
+    bool tryPush(const T& element);
+    bool tryPop(T& element);
+
+    void waitNotEmpty() const;  // consumer side
+    void waitNotFull() const;   // producer side
+
+    bool empty() const;
+    size_t size() const;
+
+   private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::array<T, N> data{};
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};  // next slot to pop, written by the consumer
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};  // next slot to push, written by the producer
+};
+
+template <typename T, size_t N>
+bool SpscQueue<T, N>::tryPush(const T& element)
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == N)
+        return false;
+
+    data[t % N] = element;
+    tail.store(t + 1, std::memory_order_release);
+    tail.notify_one();
+    return true;
+}
+
+template <typename T, size_t N>
+bool SpscQueue<T, N>::tryPop(T& element)
+{
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+        return false;
+
+    element = data[h % N];
+    head.store(h + 1, std::memory_order_release);
+    head.notify_one();
+    return true;
+}
+
+template <typename T, size_t N>
+void SpscQueue<T, N>::waitNotEmpty() const
+{
+    size_t h = head.load(std::memory_order_relaxed);
+    tail.wait(h, std::memory_order_acquire);  // returns once tail moved past head
+}
+
+template <typename T, size_t N>
+void SpscQueue<T, N>::waitNotFull() const
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t >= N)
+    {
+        head.wait(t - N, std::memory_order_acquire);  // returns once a slot was popped
+    }
+}
+
+template <typename T, size_t N>
+bool SpscQueue<T, N>::empty() const
+{
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t N>
+size_t SpscQueue<T, N>::size() const
+{
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
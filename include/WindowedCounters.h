@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+// counters of one window of simulated time
+struct MetricsWindow
+{
+    long long start = 0;  // first tick of the window
+    long long busy = 0;   // CPU time executed inside the window
+    int dispatches = 0;   // slices started inside the window
+    int completions = 0;  // processes completed inside the window
+};
+
+/*
+WindowedCounters
+    Throughput and utilization over fixed windows of simulated time, kept in a ring of `capacity`
+    windows. Memory is fixed: when time moves past the newest window the oldest one is dropped,
+    so the ring always holds the last capacity * window_ticks ticks of the run.
+
+    Time only moves forward in the scheduler. Updates for a window that was already dropped are
+    ignored, a busy period is split over the windows it covers.
+*/
+class WindowedCounters
+{
+   public:
+    static constexpr long long DEFAULT_WINDOW_TICKS = 1000;
+    static constexpr size_t DEFAULT_WINDOWS = 1024;
+
+    WindowedCounters(long long window_ticks = DEFAULT_WINDOW_TICKS,
+                     size_t capacity = DEFAULT_WINDOWS);
+
+    void addBusy(long long start, long long duration);
+    void addDispatch(long long time);
+    void addCompletion(long long time);
+    void clear();
+
+    // windows in the ring, oldest first
+    std::vector<MetricsWindow> getWindows() const;
+
+    // window size, the windows and per window utilization (%) and throughput (completions per
+    // tick); the last window is measured up to end_time.
+    json toJson(long long end_time) const;
+
+    // Query methods
+    long long getWindowTicks() const;
+    size_t getCapacity() const;
+    long long getDroppedWindows() const;
+
+   private:
+    MetricsWindow* windowAt(long long time);
+
+    std::vector<MetricsWindow> ring;
+    long long window_ticks;
+    long long newest = -1;  // window number (time / window_ticks) of the newest window
+};
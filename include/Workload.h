@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+/*
+Workload
+    Compiled binary form of a process config, loaded with mmap and no parsing. Built from the
+    json config by ConfigLoader::compileWorkload (the compile-workload tool).
+
+    File layout (little endian, as written by the host):
+        WorkloadHeader   64 bytes, magic "SCHWORKL", format version, record size and count,
+                         checksum, the scheduler config and the fixed part of the log policy
+        WorkloadRecord   20 bytes per process, fixed size
+        int32_t          pid_count pids of the log policy allowlist
+
+    The checksum is 64 bit FNV-1a over the 32 bit words after the header, continued over the
+    header itself with its checksum field set to 0. The config was validated when it was compiled,
+    loading only checks the header, the file size and the checksum.
+*/
+
+struct WorkloadHeader
+{
+    char magic[8];          // "SCHWORKL"
+    uint32_t version;       // WORKLOAD_VERSION
+    uint32_t record_size;   // sizeof(WorkloadRecord) when written
+    uint64_t record_count;  // process records after the header
+    uint64_t checksum;
+    int32_t time_quantum;
+    int32_t aging_threshold;
+    int32_t max_priority;
+    int32_t context_switch_time;
+    uint32_t event_mask;  // log policy
+    int32_t sample_every;
+    uint32_t pid_count;  // allowlisted pids after the records
+    uint8_t transitions_only;
+    uint8_t reserved[3];
+};
+
+struct WorkloadRecord
+{
+    int32_t pid;
+    int32_t priority;
+    int32_t burst;
+    int32_t io_interval;
+    uint8_t io_bound;
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(WorkloadHeader) == 64, "WorkloadHeader must be 64 bytes");
+static_assert(sizeof(WorkloadRecord) == 20, "WorkloadRecord must be 20 bytes");
+
+constexpr char WORKLOAD_MAGIC[8] = {'S', 'C', 'H', 'W', 'O', 'R', 'K', 'L'};
+constexpr uint32_t WORKLOAD_VERSION = 1;
+constexpr const char* WORKLOAD_EXTENSION = ".workload";
+
+// 64 bit FNV-1a over 32 bit words, sizes must be a multiple of 4 bytes.
+class WorkloadChecksum
+{
+   public:
+    void add(const void* data, size_t size);
+    uint64_t value() const;
+
+   private:
+    uint64_t hash = 0xcbf29ce484222325ULL;
+};
+
+/*
+WorkloadWriter
+    Streams a workload file: reserve the header, write the records and the pids, then close()
+    writes the final header with the counts and the checksum.
+*/
+class WorkloadWriter
+{
+   public:
+    // header holds the scheduler config and log policy, the rest is filled in by the writer
+    bool open(const std::filesystem::path& path, const WorkloadHeader& header);
+    void writeRecord(const WorkloadRecord& record);
+    void writePid(int32_t pid);
+    bool close();
+
+   private:
+    std::ofstream out;
+    WorkloadHeader header{};
+    WorkloadChecksum checksum;  // of everything after the header
+};
+
+/*
+MappedWorkload
+    Read only memory mapping of a workload file. The records are used in place, the mapping lives
+    as long as the object. Throws on a missing file, a bad magic, an unsupported version, a short
+    file or a checksum mismatch. POSIX only.
+*/
+class MappedWorkload
+{
+   public:
+    explicit MappedWorkload(const std::filesystem::path& path);
+    ~MappedWorkload();
+
+    MappedWorkload(const MappedWorkload&) = delete;
+    MappedWorkload& operator=(const MappedWorkload&) = delete;
+
+    // Query methods
+    const WorkloadHeader& getHeader() const;
+    const WorkloadRecord* getRecords() const;
+    size_t size() const;  // process records
+    const int32_t* getPids() const;
+
+   private:
+    void unmap();
+
+    const char* data = nullptr;
+    size_t length = 0;
+};
@@ -0,0 +1,141 @@
+#include "AgingEngine.h"
+
+#include <algorithm>
+
+AgingEngine::AgingEngine(std::vector<PCB>& process_pool) : process_pool(process_pool)
+{
+}
+
+void AgingEngine::reset()
+{
+    clock = 0;
+    tracked_count = 0;
+    enqueued_at.assign(process_pool.size(), 0);
+    generation.assign(process_pool.size(), 0);
+    tracked.assign(process_pool.size(), false);
+    deadlines = {};
+    promoted.clear();
+}
+
+void AgingEngine::track(size_t idx)
+{
+    // a process with no remaining time (burst 0) never ages, like the old pool scan.
+    if (tracked[idx] || process_pool[idx].getRemainingTime() <= 0)
+        return;
+
+    tracked[idx] = true;
+    tracked_count++;
+    enqueued_at[idx] = clock;
+    generation[idx]++;
+    schedule(idx);
+}
+
+void AgingEngine::untrack(size_t idx)
+{
+    if (!tracked[idx])
+        return;
+
+    // write the waited time back to the PCB. Can't promote here, it would already have been
+    // promoted by advance() when its deadline was reached.
+    long long waited = clock - enqueued_at[idx];
+    if (waited > 0)
+    {
+        process_pool[idx].ageProcess(static_cast<int>(waited));
+    }
+
+    tracked[idx] = false;
+    tracked_count--;
+    generation[idx]++;
+}
+
+void AgingEngine::schedule(size_t idx)
+{
+    const PCB& proc = process_pool[idx];
+
+    // priority 1 can't be promoted, its waiting time is just accumulated on untrack.
+    if (proc.getPriority() <= 1)
+        return;
+
+    long long remaining = proc.getAgingLimit() - proc.getWaitingTime();
+    deadlines.push({enqueued_at[idx] + std::max(0LL, remaining), idx, generation[idx]});
+}
+
+const std::vector<size_t>& AgingEngine::advance(int delta, size_t skip)
+{
+    promoted.clear();
+    clock += delta;
+
+    // the skipped process (the one just executed) should not wait for this delta.
+    if (skip < tracked.size() && tracked[skip] && delta != 0)
+    {
+        enqueued_at[skip] += delta;
+        generation[skip]++;
+        schedule(skip);
+    }
+
+    while (!deadlines.empty() && deadlines.top().at <= clock)
+    {
+        Deadline d = deadlines.top();
+        deadlines.pop();
+
+        if (!tracked[d.idx] || generation[d.idx] != d.generation)
+            continue;  // stale, the process left or re-entered the queue since
+
+        // same result as aging it with every delta, the threshold was first reached now.
+        if (process_pool[d.idx].ageProcess(static_cast<int>(clock - enqueued_at[d.idx])))
+        {
+            promoted.push_back(d.idx);
+            enqueued_at[d.idx] = clock;
+        }
+        else
+        {
+            enqueued_at[d.idx] = clock;
+            schedule(d.idx);
+        }
+    }
+
+    // promotions are applied in index order, like the full pool scan did.
+    std::sort(promoted.begin(), promoted.end());
+
+    if (deadlines.size() > 2 * tracked_count + 64)
+    {
+        compact();
+    }
+
+    return promoted;
+}
+
+void AgingEngine::compact()
+{
+    // drop the stale deadlines, so the heap stays proportional to the queued processes.
+    std::vector<Deadline> live;
+    live.reserve(tracked_count);
+
+    while (!deadlines.empty())
+    {
+        const Deadline& d = deadlines.top();
+        if (tracked[d.idx] && generation[d.idx] == d.generation)
+        {
+            live.push_back(d);
+        }
+        deadlines.pop();
+    }
+
+    deadlines = std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>>(
+        std::greater<>{}, std::move(live));
+}
+
+bool AgingEngine::isTracked(size_t idx) const
+{
+    return idx < tracked.size() && tracked[idx];
+}
+
+long long AgingEngine::getClock() const
+{
+    return clock;
+}
+
+size_t AgingEngine::pendingDeadlines() const
+{
+    return deadlines.size();
+}
@@ -0,0 +1,134 @@
+#include "AsyncLogWriter.h"
+
+#include <algorithm>
+#include <chrono>
+
+AsyncLogWriter::AsyncLogWriter(BatchSink sink,
+                               FlushSink flush_sink,
+                               size_t batch_records,
+                               size_t batch_count)
+    : sink(std::move(sink)),
+      flush_sink(std::move(flush_sink)),
+      batch_records(std::max<size_t>(1, batch_records))
+{
+    batches.resize(std::clamp<size_t>(batch_count, 2, MAX_BATCHES));
+    for (size_t idx = 0; idx < batches.size(); idx++)
+    {
+        batches[idx].records.reserve(this->batch_records);
+        free_batches.tryPush(idx);
+    }
+
+    writer = std::thread([this]() { writerLoop(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    close();
+}
+
+void AsyncLogWriter::write(const TraceRecord& record)
+{
+    if (!writer.joinable())
+        return;
+
+    if (current == NO_BATCH)
+        acquire();
+
+    Batch& batch = batches[current];
+    batch.records.push_back(record);
+    stats.records++;
+
+    if (batch.records.size() >= batch_records)
+        submit(false);
+}
+
+void AsyncLogWriter::flush()
+{
+    if (!writer.joinable())
+        return;
+
+    if (current == NO_BATCH)
+        acquire();
+
+    submit(true);
+    stats.flushes++;
+
+    // wait until the writer thread caught up with everything handed over so far.
+    uint64_t done = written.load(std::memory_order_acquire);
+    while (done < submitted)
+    {
+        written.wait(done, std::memory_order_acquire);
+        done = written.load(std::memory_order_acquire);
+    }
+}
+
+void AsyncLogWriter::close()
+{
+    if (!writer.joinable())
+        return;
+
+    flush();
+
+    // every batch is back after the flush, so there is room for the stop marker.
+    filled.tryPush(NO_BATCH);
+    writer.join();
+}
+
+AsyncLogStats AsyncLogWriter::getStats() const
+{
+    return stats;
+}
+
+void AsyncLogWriter::acquire()
+{
+    if (free_batches.tryPop(current))
+        return;
+
+    // backpressure, the writer thread still has every batch.
+    stats.producer_waits++;
+    auto start = std::chrono::steady_clock::now();
+    while (!free_batches.tryPop(current))
+    {
+        free_batches.waitNotEmpty();
+    }
+    auto end = std::chrono::steady_clock::now();
+    stats.producer_wait_ns +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+void AsyncLogWriter::submit(bool flush_after)
+{
+    batches[current].flush = flush_after;
+    filled.tryPush(current);  // can't fail, the queue holds every batch
+    submitted++;
+    stats.batches++;
+    current = NO_BATCH;
+}
+
+void AsyncLogWriter::writerLoop()
+{
+    while (true)
+    {
+        size_t idx;
+        while (!filled.tryPop(idx))
+        {
+            filled.waitNotEmpty();
+        }
+
+        if (idx == NO_BATCH)
+            break;
+
+        Batch& batch = batches[idx];
+        if (!batch.records.empty())
+            sink(batch.records.data(), batch.records.size());
+        if (batch.flush)
+            flush_sink();
+
+        batch.records.clear();
+        batch.flush = false;
+        free_batches.tryPush(idx);
+
+        written.fetch_add(1, std::memory_order_release);
+        written.notify_all();
+    }
+}
@@ -0,0 +1,230 @@
+#include "BinaryTrace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+#include "NdjsonWriter.h"
+
+namespace fs = std::filesystem;
+
+static constexpr uint8_t STATE_MASK = 0x3;
+static constexpr uint8_t IO_BOUND_FLAG = 0x4;
+
+TraceRecord makeTraceRecord(const PCB& p, TraceEvent event, long long timestamp)
+{
+    TraceRecord r{};
+    r.timestamp = timestamp;
+    r.pid = p.getPid();
+    r.waiting_time = p.getWaitingTime();
+    r.remaining_time = p.getRemainingTime();
+    r.cpu_used = p.getCpuUsed();
+    r.io_interval = p.getIOInterval();
+    r.prio = static_cast<uint16_t>(p.getPriority());
+    r.event = static_cast<uint8_t>(event);
+    r.flags = static_cast<uint8_t>(static_cast<uint8_t>(p.getState()) & STATE_MASK);
+    if (p.isIOBound())
+        r.flags |= IO_BOUND_FLAG;
+    return r;
+}
+
+ProcessState traceState(const TraceRecord& record)
+{
+    return static_cast<ProcessState>(record.flags & STATE_MASK);
+}
+
+bool traceIOBound(const TraceRecord& record)
+{
+    return (record.flags & IO_BOUND_FLAG) != 0;
+}
+
+json traceRecordToJson(const TraceRecord& record)
+{
+    return {{"pid", record.pid},
+            {"prio", record.prio},
+            {"event", record.event},
+            {"waiting time", record.waiting_time},
+            {"remaining time", record.remaining_time},
+            {"io bound", traceIOBound(record)},
+            {"io interval", record.io_interval},
+            {"CPU used", record.cpu_used},
+            {"Process State", PCB::stateToString(traceState(record))}};
+}
+
+//***** reading *****//
+
+// checks the header and calls func for every record, returns the number of records.
+static size_t forEachRecord(const fs::path& trace, const std::function<void(const TraceRecord&)>& func)
+{
+    std::ifstream in(trace, std::ios::binary);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("Could not open trace: " + trace.string());
+    }
+
+    TraceHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+    {
+        throw std::runtime_error("Not a scheduler trace: " + trace.string());
+    }
+    if (header.version == 0 || header.version > TRACE_VERSION)
+    {
+        throw std::runtime_error("Unsupported trace version " + std::to_string(header.version) +
+                                 " in " + trace.string());
+    }
+    if (header.record_size < sizeof(TraceRecord))
+    {
+        throw std::runtime_error("Invalid trace record size in " + trace.string());
+    }
+
+    // a file cut short by a crash only holds the whole records that made it to disk.
+    uint64_t on_disk = (fs::file_size(trace) - sizeof(header)) / header.record_size;
+    uint64_t count = std::min(header.record_count, on_disk);
+
+    const size_t chunk_records = 4096;
+    std::vector<char> chunk(chunk_records * header.record_size);
+    TraceRecord record;
+
+    uint64_t done = 0;
+    while (done < count)
+    {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(chunk_records, count - done));
+        in.read(chunk.data(), static_cast<std::streamsize>(n * header.record_size));
+        for (size_t i = 0; i < n; i++)
+        {
+            std::memcpy(&record, chunk.data() + i * header.record_size, sizeof(record));
+            func(record);
+        }
+        done += n;
+    }
+    return static_cast<size_t>(count);
+}
+
+size_t convertTraceToNdjson(const fs::path& trace, const fs::path& out)
+{
+    NdjsonWriter writer;
+    if (!writer.open(out))
+    {
+        throw std::runtime_error("Could not open: " + out.string());
+    }
+
+    size_t count =
+        forEachRecord(trace, [&writer](const TraceRecord& r) { writer.write(traceRecordToJson(r)); });
+    writer.close();
+    return count;
+}
+
+std::vector<TraceRecord> readTrace(const fs::path& trace)
+{
+    std::vector<TraceRecord> records;
+    forEachRecord(trace, [&records](const TraceRecord& r) { records.push_back(r); });
+    return records;
+}
+
+//***** TraceWriter *****//
+
+TraceWriter::TraceWriter(size_t buffer_records) : buffer_records(std::max<size_t>(1, buffer_records))
+{
+}
+
+void TraceWriter::setCap(size_t max_records)
+{
+    buffer_records = max_records == 0 ? DEFAULT_BUFFER_RECORDS : max_records;
+    buffer.shrink_to_fit();
+    buffer.reserve(buffer_records);
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::open(const fs::path& path)
+{
+    close();
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << path << " for writing\n";
+        return false;
+    }
+
+    buffer.clear();
+    buffer.reserve(buffer_records);
+    flushed_records = 0;
+    spills = 0;
+    writeHeader();
+    out.flush();
+    return true;
+}
+
+void TraceWriter::write(const TraceRecord& record)
+{
+    if (!out.is_open())
+        return;
+
+    buffer.push_back(record);
+    if (buffer.size() >= buffer_records)
+    {
+        spills++;
+        flush();
+    }
+}
+
+void TraceWriter::flush()
+{
+    if (!out.is_open())
+        return;
+
+    if (!buffer.empty())
+    {
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size() * sizeof(TraceRecord)));
+        flushed_records += buffer.size();
+        buffer.clear();
+
+        // records first, then the count that covers them.
+        out.seekp(0);
+        writeHeader();
+        out.seekp(0, std::ios::end);
+    }
+    out.flush();
+}
+
+void TraceWriter::close()
+{
+    if (!out.is_open())
+        return;
+
+    flush();
+    out.close();
+}
+
+bool TraceWriter::isOpen() const
+{
+    return out.is_open();
+}
+
+uint64_t TraceWriter::getWrittenRecords() const
+{
+    return flushed_records + buffer.size();
+}
+
+size_t TraceWriter::getSpills() const
+{
+    return spills;
+}
+
+void TraceWriter::writeHeader()
+{
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = flushed_records;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
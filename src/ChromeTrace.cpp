@@ -0,0 +1,158 @@
+#include "ChromeTrace.h"
+
+#include <format>
+#include <iostream>
+
+ChromeTraceWriter::ChromeTraceWriter(size_t buffer_size) : buffer_size(buffer_size)
+{
+}
+
+ChromeTraceWriter::~ChromeTraceWriter()
+{
+    close();
+}
+
+bool ChromeTraceWriter::open(const std::filesystem::path& path, int cpus, int io_devices)
+{
+    close();
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << path << " for writing\n";
+        return false;
+    }
+
+    buffer.clear();
+    buffer.reserve(buffer_size);
+    written_events = 0;
+
+    buffer += "[\n";
+    append(std::format(
+        R"({{"ph":"M","name":"process_name","pid":{},"args":{{"name":"Scheduler"}}}})", TRACE_PID));
+    for (int cpu = 0; cpu < cpus; cpu++)
+        trackName(cpu, "CPU " + std::to_string(cpu));
+    for (int device = 0; device < io_devices; device++)
+        trackName(IO_TRACK_BASE + device, "IO " + std::to_string(device));
+    return true;
+}
+
+void ChromeTraceWriter::cpuSlice(int cpu, int pid, int prio, long long ts, long long dur)
+{
+    if (!out.is_open())
+        return;
+
+    append(std::format(R"({{"ph":"X","cat":"cpu","name":"PID {}","pid":{},"tid":{},"ts":{},)"
+                       R"("dur":{},"args":{{"pid":{},"prio":{}}}}})",
+                       pid,
+                       TRACE_PID,
+                       cpu,
+                       ts,
+                       dur,
+                       pid,
+                       prio));
+}
+
+void ChromeTraceWriter::contextSwitch(int cpu, long long ts, long long dur)
+{
+    if (!out.is_open())
+        return;
+
+    append(std::format(
+        R"({{"ph":"X","cat":"cpu","name":"context switch","pid":{},"tid":{},"ts":{},"dur":{}}})",
+        TRACE_PID,
+        cpu,
+        ts,
+        dur));
+}
+
+void ChromeTraceWriter::ioBegin(int device, int pid, long long ts)
+{
+    if (!out.is_open())
+        return;
+
+    append(std::format(R"({{"ph":"b","cat":"io","name":"IO {}","id":{},"pid":{},"tid":{},)"
+                       R"("ts":{},"args":{{"pid":{}}}}})",
+                       device,
+                       pid,
+                       TRACE_PID,
+                       IO_TRACK_BASE + device,
+                       ts,
+                       pid));
+}
+
+void ChromeTraceWriter::ioEnd(int device, int pid, long long ts)
+{
+    if (!out.is_open())
+        return;
+
+    append(std::format(
+        R"({{"ph":"e","cat":"io","name":"IO {}","id":{},"pid":{},"tid":{},"ts":{}}})",
+        device,
+        pid,
+        TRACE_PID,
+        IO_TRACK_BASE + device,
+        ts));
+}
+
+void ChromeTraceWriter::flush()
+{
+    if (!out.is_open())
+        return;
+
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+void ChromeTraceWriter::close()
+{
+    if (!out.is_open())
+        return;
+
+    buffer += "\n]\n";
+    flush();
+    out.close();
+}
+
+bool ChromeTraceWriter::isOpen() const
+{
+    return out.is_open();
+}
+
+size_t ChromeTraceWriter::getWrittenEvents() const
+{
+    return written_events;
+}
+
+size_t ChromeTraceWriter::getBufferedBytes() const
+{
+    return buffer.size();
+}
+
+void ChromeTraceWriter::trackName(int tid, const std::string& name)
+{
+    append(std::format(
+        R"({{"ph":"M","name":"thread_name","pid":{},"tid":{},"args":{{"name":"{}"}}}})",
+        TRACE_PID,
+        tid,
+        name));
+}
+
+// events are separated by ",\n", one event per line
+void ChromeTraceWriter::append(const std::string& event)
+{
+    if (written_events > 0)
+        buffer += ",\n";
+    buffer += event;
+    written_events++;
+
+    if (buffer.size() >= buffer_size)
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
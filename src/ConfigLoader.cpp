@@ -1,15 +1,372 @@
 #include "ConfigLoader.h"
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <set>
 
 #include "LogsJson.h"
 
 static std::filesystem::path LOG_DIR = "logs";
 
+static constexpr size_t READ_BUFFER_SIZE = 1 << 20;
+
+//***** streaming parser *****//
+
+// fields of a process entry, all required
+static constexpr unsigned FIELD_PID = 1 << 0;
+static constexpr unsigned FIELD_PRIORITY = 1 << 1;
+static constexpr unsigned FIELD_BURST = 1 << 2;
+static constexpr unsigned FIELD_IO_BOUND = 1 << 3;
+static constexpr unsigned FIELD_IO_INTERVAL = 1 << 4;
+static constexpr unsigned FIELD_ALL =
+    FIELD_PID | FIELD_PRIORITY | FIELD_BURST | FIELD_IO_BOUND | FIELD_IO_INTERVAL;
+
+/*
+ConfigSaxHandler
+    Receives the SAX events of nlohmann::json and fills the ConfigLoader. The open objects and
+    arrays are tracked on a stack, together with the last key read in each object. Values are only
+    read in the known sections, anything else (unknown keys, nested values) is skipped.
+*/
+class ConfigSaxHandler : public nlohmann::json_sax<json>
+{
+   public:
+    ConfigSaxHandler(ConfigLoader& loader) : loader(loader)
+    {
+    }
+
+    bool null() override
+    {
+        return scalar(Scalar{});
+    }
+
+    bool boolean(bool val) override
+    {
+        Scalar s;
+        s.kind = Scalar::BOOL;
+        s.flag = val;
+        return scalar(s);
+    }
+
+    bool number_integer(number_integer_t val) override
+    {
+        return number(static_cast<long long>(val));
+    }
+
+    bool number_unsigned(number_unsigned_t val) override
+    {
+        return number(static_cast<long long>(val));
+    }
+
+    // 2.0 is taken as 2, a fraction (2.7) is not a number for the int fields and fails toInt
+    bool number_float(number_float_t val, const string_t& /*unused*/) override
+    {
+        if (val != std::trunc(val))
+            return scalar(Scalar{});
+        return number(static_cast<long long>(val));
+    }
+
+    bool string(string_t& val) override
+    {
+        Scalar s;
+        s.kind = Scalar::STRING;
+        s.text = &val;
+        return scalar(s);
+    }
+
+    bool binary(binary_t& /*unused*/) override
+    {
+        return scalar(Scalar{});
+    }
+
+    bool start_object(std::size_t /*unused*/) override
+    {
+        Section section = Section::SKIP;
+        if (stack.empty())
+            section = Section::ROOT;
+        else if (top() == Section::ROOT && key() == "scheduler_config")
+        {
+            section = Section::SCHEDULER;
+            loader.has_scheduler_config = true;
+        }
+        else if (top() == Section::SCHEDULER && key() == "log_policy")
+        {
+            section = Section::LOG_POLICY;
+            loader.sched_conf.log_policy = LogPolicy{};
+        }
+        else if (top() == Section::PROCESSES)
+        {
+            section = Section::PROCESS;
+            proc = ProcessConfig{};
+            fields = 0;
+        }
+
+        stack.push_back({section, {}});
+        return true;
+    }
+
+    bool key(string_t& val) override
+    {
+        stack.back().key = val;
+        return true;
+    }
+
+    bool end_object() override
+    {
+        if (top() == Section::PROCESS)
+            addProcess();
+        stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t /*unused*/) override
+    {
+        Section section = Section::SKIP;
+        if (!stack.empty() && top() == Section::ROOT && key() == "processes")
+        {
+            section = Section::PROCESSES;
+            loader.has_processes = true;
+            loader.processes.clear();
+        }
+        else if (!stack.empty() && top() == Section::LOG_POLICY && key() == "events")
+        {
+            section = Section::EVENTS;
+            loader.sched_conf.log_policy.event_mask = 0;
+        }
+        else if (!stack.empty() && top() == Section::LOG_POLICY && key() == "pids")
+        {
+            section = Section::PIDS;
+            loader.sched_conf.log_policy.pids.clear();
+        }
+
+        // arrays keep the key they were read under, for the error messages
+        stack.push_back({section, stack.empty() ? std::string{} : key()});
+        return true;
+    }
+
+    bool end_array() override
+    {
+        stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t /*unused*/,
+                     const std::string& /*unused*/,
+                     const nlohmann::detail::exception& ex) override
+    {
+        throw std::runtime_error("Error parsing config: " + std::string(ex.what()));
+    }
+
+   private:
+    enum class Section
+    {
+        ROOT,
+        SCHEDULER,
+        LOG_POLICY,
+        EVENTS,
+        PIDS,
+        PROCESSES,
+        PROCESS,
+        SKIP,
+    };
+
+    struct Frame
+    {
+        Section section;
+        std::string key;  // last key read in an object, the array's own key for an array
+    };
+
+    struct Scalar
+    {
+        enum Kind
+        {
+            NONE,
+            BOOL,
+            NUMBER,
+            STRING,
+        } kind = NONE;
+        bool flag = false;
+        long long number = 0;
+        const std::string* text = nullptr;
+    };
+
+    Section top() const
+    {
+        return stack.back().section;
+    }
+
+    const std::string& key() const
+    {
+        return stack.back().key;
+    }
+
+    bool number(long long val)
+    {
+        Scalar s;
+        s.kind = Scalar::NUMBER;
+        s.number = val;
+        return scalar(s);
+    }
+
+    bool scalar(const Scalar& s)
+    {
+        if (stack.empty())
+            return true;
+
+        switch (top())
+        {
+            case Section::SCHEDULER:
+                schedulerValue(s);
+                break;
+            case Section::LOG_POLICY:
+                logPolicyValue(s);
+                break;
+            case Section::EVENTS:
+                eventValue(s);
+                break;
+            case Section::PIDS:
+                loader.sched_conf.log_policy.pids.push_back(toInt(s, "log_policy"));
+                break;
+            case Section::PROCESS:
+                processValue(s);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    // the error message is only built on failure, e.g. "Error in time_quantum in scheduler config"
+    int toInt(const Scalar& s, const char* where) const
+    {
+        if (s.kind != Scalar::NUMBER)
+            throw std::runtime_error("Error in " + key() + " in " + where);
+        return static_cast<int>(s.number);
+    }
+
+    bool toBool(const Scalar& s, const char* where) const
+    {
+        if (s.kind != Scalar::BOOL)
+            throw std::runtime_error("Error in " + key() + " in " + where);
+        return s.flag;
+    }
+
+    // the ranges are checked by validateSchedulerConfig
+    void schedulerValue(const Scalar& s)
+    {
+        SchedulerConfig& conf = loader.sched_conf;
+        const std::string& name = key();
+
+        if (name == "time_quantum")
+        {
+            conf.time_quantum = toInt(s, "scheduler config");
+        }
+        else if (name == "max_priority")
+        {
+            conf.max_priority = toInt(s, "scheduler config");
+        }
+        else if (name == "aging_threshold")
+        {
+            conf.aging_threshold = toInt(s, "scheduler config");
+        }
+        else if (name == "context_switch_time")
+        {
+            conf.context_switch_time = toInt(s, "scheduler config");
+        }
+    }
+
+    // the optional event log policy, every field defaults to logging everything
+    void logPolicyValue(const Scalar& s)
+    {
+        LogPolicy& policy = loader.sched_conf.log_policy;
+        const std::string& name = key();
+
+        if (name == "sample_every")
+        {
+            policy.sample_every = toInt(s, "log_policy");
+        }
+        else if (name == "transitions_only")
+        {
+            policy.transitions_only = toBool(s, "log_policy");
+        }
+        else if (name == "events" || name == "pids")
+        {
+            throw std::runtime_error("Error in " + name + " in log_policy - expected an array");
+        }
+    }
+
+    void eventValue(const Scalar& s)
+    {
+        if (s.kind != Scalar::STRING)
+            throw std::runtime_error("Error in events in log_policy");
+
+        unsigned& mask = loader.sched_conf.log_policy.event_mask;
+        const std::string& event = *s.text;
+        if (event == "RUNNING")
+            mask |= LOG_EVENT_RUNNING;
+        else if (event == "IO_WAIT")
+            mask |= LOG_EVENT_IO_WAIT;
+        else if (event == "FINISHED")
+            mask |= LOG_EVENT_FINISHED;
+        else
+            throw std::runtime_error("Error in log_policy - unknown event: " + event);
+    }
+
+    void processValue(const Scalar& s)
+    {
+        const std::string& name = key();
+        const char* where = "process config";
+
+        if (name == "pid")
+        {
+            proc.pid = toInt(s, where);
+            fields |= FIELD_PID;
+        }
+        else if (name == "priority")
+        {
+            proc.priority = toInt(s, where);
+            fields |= FIELD_PRIORITY;
+        }
+        else if (name == "burst_time")
+        {
+            proc.burst = toInt(s, where);
+            fields |= FIELD_BURST;
+        }
+        else if (name == "io_bound")
+        {
+            proc.io_bound = toBool(s, where);
+            fields |= FIELD_IO_BOUND;
+        }
+        else if (name == "io_interval")
+        {
+            proc.io_interval = toInt(s, where);
+            fields |= FIELD_IO_INTERVAL;
+        }
+    }
+
+    void addProcess()
+    {
+        if (fields != FIELD_ALL)
+        {
+            throw std::runtime_error("Error in process config - missing field in process " +
+                                     std::to_string(loader.processes.size() + 1));
+        }
+
+        std::vector<ProcessConfig>& processes = loader.processes;
+        if (!processes.empty() && proc.pid <= processes.back().pid)
+            loader.pids_ascending = false;
+        processes.push_back(proc);
+    }
+
+    ConfigLoader& loader;
+    std::vector<Frame> stack;
+    ProcessConfig proc{};  // process entry being read
+    unsigned fields = 0;   // FIELD_ bits read for proc
+};
+
+//***** ConfigLoader *****//
+
 ConfigLoader::ConfigLoader(const std::string& config_file) : config_file(config_file)
 {
     loadFromFile();
@@ -18,33 +375,102 @@ ConfigLoader::ConfigLoader(const std::string& config_file) : config_file(config_
 
 void ConfigLoader::loadFromFile()
 {
-    std::ifstream file(LOG_DIR / extensionJSON(config_file));
+    sched_conf.time_quantum = DEFAULT_TIME_QUANTUM;
+    sched_conf.max_priority = DEFAULT_MAX_PRIORITY;
+    sched_conf.aging_threshold = DEFAULT_AGING_THRESHOLD;
+    sched_conf.context_switch_time = DEFAULT_AGING_THRESHOLD;
+    sched_conf.log_policy = LogPolicy{};
+
+    std::filesystem::path path = LOG_DIR / config_file;
+    if (path.extension() == WORKLOAD_EXTENSION)
+    {
+        loadWorkload(path);
+        return;
+    }
+
+    std::vector<char> buffer(READ_BUFFER_SIZE);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(LOG_DIR / extensionJSON(config_file), std::ios::binary);
     if (!file.is_open())
     {
         throw std::runtime_error("Error opening file: " + config_file);
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    config_data = json::parse(buffer.str());
+    ConfigSaxHandler handler(*this);
+    json::sax_parse(file, &handler);
+}
+
+// the config is taken as is, it was validated when it was compiled
+void ConfigLoader::loadWorkload(const std::filesystem::path& path)
+{
+    workload.emplace(path);
+    const WorkloadHeader& header = workload->getHeader();
+
+    sched_conf.time_quantum = header.time_quantum;
+    sched_conf.aging_threshold = header.aging_threshold;
+    sched_conf.max_priority = header.max_priority;
+    sched_conf.context_switch_time = header.context_switch_time;
+    sched_conf.log_policy.event_mask = header.event_mask;
+    sched_conf.log_policy.sample_every = header.sample_every;
+    sched_conf.log_policy.transitions_only = header.transitions_only != 0;
+    sched_conf.log_policy.pids.assign(workload->getPids(),
+                                      workload->getPids() + header.pid_count);
+
+    has_scheduler_config = true;
+    has_processes = true;
+}
+
+bool ConfigLoader::compileWorkload(const std::filesystem::path& out) const
+{
+    WorkloadHeader header{};
+    header.time_quantum = sched_conf.time_quantum;
+    header.aging_threshold = sched_conf.aging_threshold;
+    header.max_priority = sched_conf.max_priority;
+    header.context_switch_time = sched_conf.context_switch_time;
+    header.event_mask = sched_conf.log_policy.event_mask;
+    header.sample_every = sched_conf.log_policy.sample_every;
+    header.transitions_only = sched_conf.log_policy.transitions_only ? 1 : 0;
+
+    WorkloadWriter writer;
+    if (!writer.open(out, header))
+        return false;
+
+    forEachProcess(
+        [&writer](const ProcessConfig& p)
+        {
+            WorkloadRecord r{};
+            r.pid = p.pid;
+            r.priority = p.priority;
+            r.burst = p.burst;
+            r.io_interval = p.io_interval;
+            r.io_bound = p.io_bound ? 1 : 0;
+            writer.writeRecord(r);
+        });
+    for (int pid : sched_conf.log_policy.pids)
+        writer.writePid(pid);
+
+    return writer.close();
 }
 
-std::vector<ProcessConfig> ConfigLoader::getProcessConfig() const
+const std::vector<ProcessConfig>& ConfigLoader::getProcessConfig() const
 {
-    std::vector<ProcessConfig> vector_conf;
-    auto sched = config_data["processes"];
-    for (const auto& i : sched)
+    if (workload && processes.empty())
     {
-        ProcessConfig proc;
-        proc.pid = i["pid"];
-        proc.priority = i["priority"];
-        proc.burst = i["burst_time"];
-        proc.io_bound = i["io_bound"];
-        proc.io_interval = i["io_interval"];
-        vector_conf.push_back(proc);
+        processes.reserve(workload->size());
+        forEachProcess([this](const ProcessConfig& p) { processes.push_back(p); });
     }
+    return processes;
+}
 
-    return vector_conf;
+size_t ConfigLoader::getProcessCount() const
+{
+    return workload ? workload->size() : processes.size();
+}
+
+bool ConfigLoader::isCompiledWorkload() const
+{
+    return workload.has_value();
 }
 
 const SchedulerConfig& ConfigLoader::getSchedulerConfig() const
@@ -58,112 +484,67 @@ void ConfigLoader::validate()
     validateProcessConfig();
 }
 
-// validate the required scheduler config numbers are inside the demands
-void ConfigLoader::validateSchedulerConfig()
+// validate the scheduler config numbers are inside the demands
+void ConfigLoader::validateSchedulerConfig() const
 {
-    if (!config_data.contains("scheduler_config"))
+    if (!has_scheduler_config)
     {
         throw std::runtime_error("Error in scheduler config - missing scheduler_config");
     }
 
-    auto sched = config_data["scheduler_config"];
-
-    if (sched.contains("time_quantum"))
-    {
-        int val = sched["time_quantum"].get<int>();
-        if (val <= 0)
-        {
-            throw std::runtime_error("Error in time_quantum in scheduler config");
-        }
-        sched_conf.time_quantum = val;
-    }
-    else
+    if (sched_conf.time_quantum <= 0)
     {
-        sched_conf.time_quantum = DEFAULT_TIME_QUANTUM;
+        throw std::runtime_error("Error in time_quantum in scheduler config");
     }
 
-    if (sched.contains("max_priority"))
+    if (sched_conf.max_priority > MAX_PRIORITY_LEVELS || sched_conf.max_priority <= 0)
     {
-        int val = sched["max_priority"].get<int>();
-        if (val > 10 || val <= 0)
-        {
-            throw std::runtime_error("Error in max_priority in scheduler config");
-        }
-        sched_conf.max_priority = val;
-    }
-    else
-    {
-        sched_conf.max_priority = DEFAULT_MAX_PRIORITY;
+        throw std::runtime_error("Error in max_priority in scheduler config");
     }
 
-    if (sched.contains("aging_threshold"))
-    {
-        int val = sched["aging_threshold"].get<int>();
-        if (val <= 0)
-        {
-            throw std::runtime_error("Error in aging_threshold in scheduler config");
-        }
-        sched_conf.aging_threshold = val;
-    }
-    else
+    if (sched_conf.aging_threshold <= 0)
     {
-        sched_conf.aging_threshold = DEFAULT_AGING_THRESHOLD;
+        throw std::runtime_error("Error in aging_threshold in scheduler config");
     }
 
-    if (sched.contains("context_switch_time"))
+    if (sched_conf.context_switch_time <= 0)
     {
-        int val = sched["context_switch_time"].get<int>();
-        if (val <= 0)
-        {
-            throw std::runtime_error("Error in context_switch_time in scheduler config");
-        }
-        sched_conf.context_switch_time = val;
+        throw std::runtime_error("Error in context_switch_time in scheduler config");
     }
-    else
+
+    if (sched_conf.log_policy.sample_every <= 0)
     {
-        sched_conf.context_switch_time = DEFAULT_AGING_THRESHOLD;
+        throw std::runtime_error("Error in sample_every in log_policy");
     }
 }
 
 // validate process config for e.g no duplicate pids
 void ConfigLoader::validateProcessConfig() const
 {
-    if (!config_data.contains("processes"))
+    if (!has_processes)
     {
         throw std::runtime_error("Error in process config - missing process array");
     }
 
-    if (config_data["processes"].empty())
+    if (getProcessCount() == 0)
     {
         throw std::runtime_error("Error in process config - empty process array");
     }
 
-    std::vector<ProcessConfig> vector_conf = getProcessConfig();
-    auto sched = config_data["processes"];
-
-    std::set<int> processSet;
+    // pids in ascending order can't repeat, otherwise sort a copy of them. A compiled workload
+    // was checked when it was compiled.
+    if (pids_ascending || workload)
+        return;
 
-    /* lidt lambda teknik, for sjov.
+    std::vector<int> pids;
+    pids.reserve(processes.size());
+    for (const auto& p : processes)
+        pids.push_back(p.pid);
+    std::sort(pids.begin(), pids.end());
 
-    - I realiteten behøves kun nedenstående, fordi set ikke kan have duplicates, og dernæst kan size
-    tjekkes: for(auto& p : vector_conf){ processSet.insert(p.pid);
-    }
-
-    */
-    auto it = std::find_if(std::begin(vector_conf),
-                           std::end(vector_conf),
-                           [&processSet](const ProcessConfig& p)
-                           {
-                               if (processSet.find(p.pid) != processSet.end())
-                                   return true;
-
-                               else
-                                   processSet.insert(p.pid);
-                               return false;
-                           });
-
-    if (it != vector_conf.end())
+    auto it = std::adjacent_find(pids.begin(), pids.end());
+    if (it != pids.end())
     {
-        throw std::runtime_error("Duplicate PID found: " + std::to_string(it->pid));
+        throw std::runtime_error("Duplicate PID found: " + std::to_string(*it));
     }
-}
\ No newline at end of file
+}
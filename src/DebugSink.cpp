@@ -0,0 +1,251 @@
+#include "DebugSink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iterator>
+
+std::atomic<DebugSink*> DebugSink::crash_sinks{nullptr};
+
+static constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(50);
+static constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
+static constexpr size_t CRASH_SIGNAL_COUNT = std::size(CRASH_SIGNALS);
+
+// handlers installed before the first sink, chained to and restored by the last one.
+// handlers_lock also guards the changes to the crash_sinks list.
+static struct sigaction previous_actions[CRASH_SIGNAL_COUNT];
+static std::mutex handlers_lock;
+static int live_sinks = 0;
+
+DebugSink::DebugSink(Mode mode, size_t capacity, int fd)
+    : mode(mode), fd(fd), ring(std::max<size_t>(capacity, 64))
+{
+    linkCrashSink();
+
+    if (mode == Mode::DRAIN)
+        drainer = std::thread([this]() { drainLoop(); });
+}
+
+DebugSink::~DebugSink()
+{
+    if (drainer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        data_ready.notify_one();
+        drainer.join();  // the drain thread outputs what is left before it stops
+    }
+    else
+    {
+        flush();
+    }
+
+    unlinkCrashSink();
+}
+
+void DebugSink::write(std::string_view line)
+{
+    const uint64_t capacity = ring.size();
+    line = line.substr(0, capacity - 1);
+    const uint64_t n = line.size() + 1;
+
+    std::unique_lock<std::mutex> guard(lock);
+    // only written under the lock, the release stores publish the bytes to the crash handler.
+    uint64_t at = head.load(std::memory_order_relaxed);
+    uint64_t from = tail.load(std::memory_order_relaxed);
+    if (at - from + n > capacity)
+    {
+        if (mode == Mode::DRAIN)
+        {
+            stats.producer_waits++;
+            data_ready.notify_one();
+            space_free.wait(guard, [&]() { return head.load() - tail.load() + n <= capacity; });
+            at = head.load(std::memory_order_relaxed);  // other writers may have run meanwhile
+            from = tail.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            // overwrite the oldest output, and keep the ring starting at a whole line.
+            uint64_t new_tail = at + n - capacity;
+            while (new_tail < at && ring[new_tail % capacity] != '\n')
+                new_tail++;
+            new_tail = std::min(new_tail + 1, at);
+            stats.dropped_bytes += new_tail - from;
+            from = new_tail;
+            tail.store(from, std::memory_order_release);
+        }
+    }
+
+    size_t pos = static_cast<size_t>(at % capacity);
+    size_t first = std::min<size_t>(line.size(), capacity - pos);
+    std::memcpy(ring.data() + pos, line.data(), first);
+    std::memcpy(ring.data(), line.data() + first, line.size() - first);
+    ring[(at + line.size()) % capacity] = '\n';
+    head.store(at + n, std::memory_order_release);
+    stats.lines++;
+
+    // wake the drain thread early when half the ring is used, otherwise it drains on its interval.
+    if (mode == Mode::DRAIN && at + n - from >= capacity / 2)
+        data_ready.notify_one();
+}
+
+void DebugSink::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (mode == Mode::DRAIN)
+    {
+        uint64_t target = head.load();
+        data_ready.notify_one();
+        space_free.wait(guard, [&]() { return tail.load() >= target; });
+        return;
+    }
+
+    uint64_t to = head.load();
+    output(tail.load(), to);
+    tail.store(to);
+}
+
+DebugSink::Mode DebugSink::getMode() const
+{
+    return mode;
+}
+
+size_t DebugSink::getCapacity() const
+{
+    return ring.size();
+}
+
+size_t DebugSink::getBufferedBytes() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<size_t>(head.load() - tail.load());
+}
+
+DebugSinkStats DebugSink::getStats() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+void DebugSink::drainLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        data_ready.wait_for(
+            guard, DRAIN_INTERVAL, [&]() { return stopping || head.load() != tail.load(); });
+        uint64_t from = tail.load(), to = head.load();
+        if (from == to)
+        {
+            if (stopping)
+                return;
+            continue;
+        }
+
+        // writers only append past head, so [tail, head) can be output without the lock.
+        guard.unlock();
+        output(from, to);
+        guard.lock();
+
+        tail.store(to);
+        space_free.notify_all();
+    }
+}
+
+void DebugSink::output(uint64_t from, uint64_t to)
+{
+    const uint64_t capacity = ring.size();
+    while (from < to)
+    {
+        size_t pos = static_cast<size_t>(from % capacity);
+        size_t len = static_cast<size_t>(std::min<uint64_t>(to - from, capacity - pos));
+        ssize_t done = ::write(fd, ring.data() + pos, len);
+        if (done < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return;  // nowhere to report it, the debug output is lost
+        }
+        from += static_cast<uint64_t>(done);
+    }
+}
+
+//***** crash handlers *****//
+
+void DebugSink::linkCrashSink()
+{
+    std::lock_guard<std::mutex> guard(handlers_lock);
+    if (live_sinks++ == 0)
+        installCrashHandlers();
+
+    next_crash_sink.store(crash_sinks.load());
+    crash_sinks.store(this);
+}
+
+// only this sink leaves the list, older sinks stay dumped on a crash.
+void DebugSink::unlinkCrashSink()
+{
+    std::lock_guard<std::mutex> guard(handlers_lock);
+    std::atomic<DebugSink*>* link = &crash_sinks;
+    while (link->load() != nullptr && link->load() != this)
+        link = &link->load()->next_crash_sink;
+    if (link->load() == this)
+        link->store(next_crash_sink.load());
+
+    if (--live_sinks == 0)
+        restoreCrashHandlers();
+}
+
+void DebugSink::installCrashHandlers()
+{
+    struct sigaction action{};
+    action.sa_sigaction = &DebugSink::crashHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < CRASH_SIGNAL_COUNT; i++)
+        sigaction(CRASH_SIGNALS[i], &action, &previous_actions[i]);
+}
+
+void DebugSink::restoreCrashHandlers()
+{
+    for (size_t i = 0; i < CRASH_SIGNAL_COUNT; i++)
+        sigaction(CRASH_SIGNALS[i], &previous_actions[i], nullptr);
+}
+
+// only write(2) and sigaction from here, the lock may be held by the crashing thread.
+void DebugSink::crashHandler(int sig, siginfo_t* info, void* context)
+{
+    for (DebugSink* sink = crash_sinks.load(); sink != nullptr; sink = sink->next_crash_sink.load())
+    {
+        sink->output(sink->tail.load(), sink->head.load());
+    }
+
+    size_t slot = 0;
+    while (slot < CRASH_SIGNAL_COUNT && CRASH_SIGNALS[slot] != sig)
+        slot++;
+    if (slot == CRASH_SIGNAL_COUNT)
+        return;
+
+    // chain to the previous handler with the original siginfo
+    const struct sigaction& previous = previous_actions[slot];
+    if ((previous.sa_flags & SA_SIGINFO) != 0 && previous.sa_sigaction != nullptr)
+    {
+        previous.sa_sigaction(sig, info, context);
+        return;
+    }
+    if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+    {
+        previous.sa_handler(sig);
+        return;
+    }
+
+    // default or ignored: put it back and raise again, delivered once this handler returns.
+    // An ignored fault (SIGSEGV, ...) re-faults on return and the kernel then uses the default.
+    sigaction(sig, &previous, nullptr);
+    if (previous.sa_handler == SIG_DFL)
+        std::raise(sig);
+}
@@ -0,0 +1,55 @@
+#include "EventCalendar.h"
+
+#include <stdexcept>
+
+void EventCalendar::schedule(long long time, EventType type, size_t idx)
+{
+    events.push({time, next_seq++, type, idx});
+}
+
+Event EventCalendar::pop()
+{
+    if (events.empty())
+    {
+        throw std::runtime_error("Event calendar empty");
+    }
+
+    Event ev = events.top();
+    events.pop();
+    return ev;
+}
+
+const Event& EventCalendar::peek() const
+{
+    if (events.empty())
+    {
+        throw std::runtime_error("Event calendar empty");
+    }
+    return events.top();
+}
+
+void EventCalendar::clear()
+{
+    events = {};
+    next_seq = 0;
+}
+
+bool EventCalendar::empty() const
+{
+    return events.empty();
+}
+
+size_t EventCalendar::size() const
+{
+    return events.size();
+}
+
+long long EventCalendar::nextTime() const
+{
+    return peek().time;
+}
+
+uint64_t EventCalendar::getScheduledCount() const
+{
+    return next_seq;
+}
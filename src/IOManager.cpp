@@ -10,55 +10,75 @@ IOManager::IOManager(std::vector<PCB>& process_pool) : process_pool(process_pool
 
 void IOManager::enqueue(size_t idx)
 {
-    IO_queue.push_back(idx);
+    if (idx >= heap_pos.size())
+    {
+        heap_pos.resize(std::max(idx + 1, process_pool.size()), NPOS);
+    }
+
+    if (heap_pos[idx] != NPOS)
+        return;  // already waiting on IO
+
+    // completes after whatever IO time the process has left (0 until the IO is started).
+    PCB& proc = process_pool[idx];
+    pid_index.try_emplace(proc.getPid(), idx);
+    heapPush({io_clock + proc.getIORemainingTime(), io_clock, next_seq++, idx});
+    pending.push_back(idx);
 }
 
 void IOManager::updateIO()
 {
-    if (IO_queue.empty())
+    if (pending.empty())
         return;
 
-    for (size_t idx : IO_queue)
+    // only the processes enqueued since the last call can need their IO started.
+    for (size_t idx : pending)
     {
-        PCB& proc = process_pool[idx];
+        if (heap_pos[idx] == NPOS)
+            continue;  // already completed or cancelled
 
-        if (proc.isWaitingIO() && proc.isIOBound() && proc.getRemainingTime() > 0)
+        PCB& proc = process_pool[idx];
+        if (proc.isWaitingIO() && proc.isIOBound() && proc.getRemainingTime() > 0 &&
+            proc.getIORemainingTime() == 0)
         {
-            if (proc.getIORemainingTime() == 0)
-                proc.startIO();
+            proc.startIO();
+
+            size_t pos = heap_pos[idx];
+            Entry e = heap[pos];
+            e.done_at = io_clock + proc.getIORemainingTime();
+            e.set_at = io_clock;
+            place(pos, e);
+            siftUp(pos);
+            siftDown(heap_pos[idx]);
         }
     }
+    pending.clear();
 }
 
 void IOManager::processIO(int timeslice)
 {
     // Phase 1 -> Find finished i/O processes
-    if (IO_queue.empty())
+    if (heap.empty())
         return;
 
     int time_diff = std::max(0, timeslice);  // secure time_diff is positive.
+    io_clock += time_diff;
 
-    for (size_t idx : IO_queue)
+    completed.clear();
+    while (!heap.empty() && heap.front().done_at <= io_clock)
     {
-        PCB& proc = process_pool[idx];
-        if (proc.getIORemainingTime() > 0)
-        {
-            int io_time_passed = std::min(proc.getIORemainingTime(), time_diff);
-
-            proc.setIOTime(proc.getIORemainingTime() - io_time_passed);
-
-            if (proc.getIORemainingTime() < 0)  // if it goes to 0 temporarily, clamp it.
-            {
-                proc.setIOTime(0);
-            }
+        completed.push_back(heapPop());
+    }
 
-            proc.incrementTotalIO(io_time_passed);
-        }
+    // report them in the order they entered IO, like the FIFO IO queue did.
+    std::sort(completed.begin(),
+              completed.end(),
+              [](const Entry& a, const Entry& b) { return a.seq < b.seq; });
 
-        if (proc.getIORemainingTime() <= 0)
-        {
-            finished_IO.push_back(idx);
-        }
+    for (const Entry& e : completed)
+    {
+        // the whole IO time passed, sum of every slice it was advanced with.
+        process_pool[e.idx].incrementTotalIO(static_cast<int>(e.done_at - e.set_at));
+        finished_IO.push_back(e.idx);
     }
 
     handleIOqueue();
@@ -66,21 +86,29 @@ void IOManager::processIO(int timeslice)
 
 void IOManager::handleIOqueue()
 {
-    // Phase 2 -> Reinsert, delete and cleanup.
-    if (IO_queue.empty())
-        return;
-
+    // Phase 2 -> reset the finished processes, they are already out of the heap.
     for (size_t idx : finished_IO)
     {
         PCB& proc = process_pool[idx];
         proc.resetIO();  // sets waiting_IO flag.
     }
+}
 
-    // remove all finished process, by detecting waiting_IO flag.
-    IO_queue.erase(std::remove_if(IO_queue.begin(),
-                                  IO_queue.end(),
-                                  [&](size_t idx) { return !(process_pool[idx].isWaitingIO()); }),
-                   IO_queue.end());
+bool IOManager::cancel(size_t idx)
+{
+    if (!contains(idx))
+        return false;
+
+    size_t pos = heap_pos[idx];
+    const Entry& e = heap[pos];
+
+    // keep the IO time that already passed, and what is left in the PCB.
+    PCB& proc = process_pool[idx];
+    proc.incrementTotalIO(static_cast<int>(io_clock - e.set_at));
+    proc.setIOTime(static_cast<int>(e.done_at - io_clock));
+
+    heapErase(pos);
+    return true;
 }
 
 const std::vector<size_t>& IOManager::getFinishedProcesses() const
@@ -90,24 +118,46 @@ const std::vector<size_t>& IOManager::getFinishedProcesses() const
 
 bool IOManager::isEmpty() const
 {
-    return IO_queue.empty();
+    return heap.empty();
 }
 
 size_t IOManager::size() const
 {
-    return IO_queue.size();
+    return heap.size();
+}
+
+bool IOManager::contains(size_t idx) const
+{
+    return idx < heap_pos.size() && heap_pos[idx] != NPOS;
 }
 
 bool IOManager::containsPID(int pid) const
 {
-    return (std::any_of(IO_queue.begin(),
-                        IO_queue.end(),
-                        [pid, this](size_t idx) { return pid == process_pool[idx].getPid(); }));
+    auto it = pid_index.find(pid);
+    return it != pid_index.end() && contains(it->second);
+}
+
+int IOManager::getRemainingIOTime(size_t idx) const
+{
+    if (!contains(idx))
+        return 0;
+
+    return static_cast<int>(heap[heap_pos[idx]].done_at - io_clock);
+}
+
+long long IOManager::getIOClock() const
+{
+    return io_clock;
 }
 
 void IOManager::clear()
 {
-    IO_queue.clear();
+    for (const Entry& e : heap)
+    {
+        heap_pos[e.idx] = NPOS;
+    }
+    heap.clear();
+    pending.clear();
     finished_IO.clear();
 }
 
@@ -118,28 +168,111 @@ void IOManager::clearFinished()
 
 int IOManager::getMinRemainingIOTime() const
 {
-    int min = INT_MAX;
-    for (size_t idx : IO_queue)
-    {
-        PCB& proc = process_pool[idx];
-        if (proc.getIORemainingTime() < min)
-        {
-            min = proc.getIORemainingTime();
-        }
-    }
+    if (heap.empty())
+        return INT_MAX;
 
-    return min;
+    return static_cast<int>(heap.front().done_at - io_clock);
 };
 
-const std::deque<size_t>& IOManager::getQueue() const
+// waiting processes in the order they entered IO.
+std::vector<size_t> IOManager::getQueue() const
 {
-    return IO_queue;
+    std::vector<Entry> entries(heap);
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const Entry& a, const Entry& b) { return a.seq < b.seq; });
+
+    std::vector<size_t> queue;
+    queue.reserve(entries.size());
+    for (const Entry& e : entries)
+    {
+        queue.push_back(e.idx);
+    }
+    return queue;
 }
 
 void IOManager::printQueue() const
 {
-    for (const auto& p : IO_queue)
+    for (const auto& p : getQueue())
     {
         std::cout << p << std::endl;
     }
 }
+
+//***** indexed min-heap on (done_at, seq) *****//
+
+bool IOManager::before(const Entry& a, const Entry& b) const
+{
+    return a.done_at != b.done_at ? a.done_at < b.done_at : a.seq < b.seq;
+}
+
+void IOManager::place(size_t pos, const Entry& e)
+{
+    heap[pos] = e;
+    heap_pos[e.idx] = pos;
+}
+
+void IOManager::heapPush(const Entry& e)
+{
+    heap.push_back(e);
+    heap_pos[e.idx] = heap.size() - 1;
+    siftUp(heap.size() - 1);
+}
+
+IOManager::Entry IOManager::heapPop()
+{
+    Entry top = heap.front();
+    heapErase(0);
+    return top;
+}
+
+void IOManager::heapErase(size_t pos)
+{
+    heap_pos[heap[pos].idx] = NPOS;
+
+    Entry last = heap.back();
+    heap.pop_back();
+    if (pos == heap.size())
+        return;
+
+    place(pos, last);
+    siftUp(pos);
+    siftDown(heap_pos[last.idx]);
+}
+
+void IOManager::siftUp(size_t pos)
+{
+    Entry e = heap[pos];
+    while (pos > 0)
+    {
+        size_t parent = (pos - 1) / 2;
+        if (!before(e, heap[parent]))
+            break;
+
+        place(pos, heap[parent]);
+        pos = parent;
+    }
+    place(pos, e);
+}
+
+void IOManager::siftDown(size_t pos)
+{
+    Entry e = heap[pos];
+    const size_t n = heap.size();
+    while (true)
+    {
+        size_t child = 2 * pos + 1;
+        if (child >= n)
+            break;
+
+        if (child + 1 < n && before(heap[child + 1], heap[child]))
+            child++;
+
+        if (!before(heap[child], e))
+            break;
+
+        place(pos, heap[child]);
+        pos = child;
+    }
+    place(pos, e);
+}
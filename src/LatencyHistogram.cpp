@@ -0,0 +1,190 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+static constexpr long long SUB_BUCKETS = 1LL << LatencyHistogram::SUB_BUCKET_BITS;
+static constexpr long long HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+
+//***** bucket layout *****//
+/*
+    [0, SUB_BUCKETS)               one bucket per value
+    [2^k, 2^(k+1)), k >= BITS      HALF_SUB_BUCKETS buckets of width 2^(k - BITS + 1)
+*/
+
+size_t LatencyHistogram::bucketIndex(long long value)
+{
+    if (value < SUB_BUCKETS)
+        return static_cast<size_t>(std::max(0LL, value));
+
+    int shift = std::bit_width(static_cast<uint64_t>(value)) - SUB_BUCKET_BITS;  // >= 1
+    long long mantissa = value >> shift;  // in [HALF_SUB_BUCKETS, SUB_BUCKETS)
+    return static_cast<size_t>(SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS +
+                               (mantissa - HALF_SUB_BUCKETS));
+}
+
+long long LatencyHistogram::bucketLowest(size_t index)
+{
+    long long idx = static_cast<long long>(index);
+    if (idx < SUB_BUCKETS)
+        return idx;
+
+    long long shift = (idx - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+    long long mantissa = (idx - SUB_BUCKETS) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+    return mantissa << shift;
+}
+
+long long LatencyHistogram::bucketHighest(size_t index)
+{
+    return bucketLowest(index + 1) - 1;
+}
+
+//***** recording *****//
+
+void LatencyHistogram::record(long long value, uint64_t count)
+{
+    if (count == 0)
+        return;
+
+    value = std::max(0LL, value);
+    size_t idx = bucketIndex(value);
+    if (idx >= counts.size())
+        counts.resize(idx + 1, 0);
+
+    counts[idx] += count;
+    min = total == 0 ? value : std::min(min, value);
+    max = total == 0 ? value : std::max(max, value);
+    total += count;
+    sum += static_cast<long double>(value) * count;
+}
+
+void LatencyHistogram::remove(long long value, uint64_t count)
+{
+    value = std::max(0LL, value);
+    size_t idx = bucketIndex(value);
+    if (idx >= counts.size())
+        return;
+
+    count = std::min(count, counts[idx]);
+    counts[idx] -= count;
+    total -= count;
+    sum -= static_cast<long double>(value) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.total == 0)
+        return;
+
+    if (other.counts.size() > counts.size())
+        counts.resize(other.counts.size(), 0);
+    for (size_t idx = 0; idx < other.counts.size(); idx++)
+        counts[idx] += other.counts[idx];
+
+    min = total == 0 ? other.min : std::min(min, other.min);
+    max = total == 0 ? other.max : std::max(max, other.max);
+    total += other.total;
+    sum += other.sum;
+}
+
+void LatencyHistogram::clear()
+{
+    counts.clear();
+    total = 0;
+    min = 0;
+    max = 0;
+    sum = 0;
+}
+
+long long LatencyHistogram::percentile(double percentile) const
+{
+    if (total == 0)
+        return 0;
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t idx = 0; idx < counts.size(); idx++)
+    {
+        seen += counts[idx];
+        if (seen >= rank)
+            return std::clamp(bucketHighest(idx), min, max);
+    }
+    return max;
+}
+
+//***** queries *****//
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return total;
+}
+
+long long LatencyHistogram::getMin() const
+{
+    return min;
+}
+
+long long LatencyHistogram::getMax() const
+{
+    return max;
+}
+
+double LatencyHistogram::getMean() const
+{
+    return total == 0 ? 0.0 : static_cast<double>(sum / total);
+}
+
+size_t LatencyHistogram::getBucketCount() const
+{
+    return counts.size();
+}
+
+//***** json *****//
+
+json LatencyHistogram::toJson() const
+{
+    json buckets = json::array();
+    for (size_t idx = 0; idx < counts.size(); idx++)
+    {
+        if (counts[idx] != 0)
+            buckets.push_back({bucketLowest(idx), counts[idx]});
+    }
+
+    return {{"count", total},
+            {"min", min},
+            {"max", max},
+            {"mean", getMean()},
+            {"p50", percentile(50.0)},
+            {"p90", percentile(90.0)},
+            {"p99", percentile(99.0)},
+            {"p99.9", percentile(99.9)},
+            {"buckets", buckets}};
+}
+
+LatencyHistogram LatencyHistogram::fromJson(const json& j)
+{
+    LatencyHistogram h;
+    for (const auto& bucket : j.at("buckets"))
+    {
+        long long lowest = bucket.at(0).get<long long>();
+        uint64_t count = bucket.at(1).get<uint64_t>();
+        size_t idx = bucketIndex(lowest);
+        if (idx >= h.counts.size())
+            h.counts.resize(idx + 1, 0);
+        h.counts[idx] += count;
+        h.total += count;
+    }
+
+    // the exact extremes and mean come from the summary, the buckets only hold ranges.
+    if (h.total != 0)
+    {
+        h.min = j.at("min").get<long long>();
+        h.max = j.at("max").get<long long>();
+        h.sum = static_cast<long double>(j.at("mean").get<double>()) * h.total;
+    }
+    return h;
+}
@@ -10,6 +10,12 @@ Consider Adding Atomic Write.
 namespace fs = std::filesystem;
 static fs::path LOG_DIR = "logs";
 
+static bool endsWith(const std::string& filename, const std::string& ext)
+{
+    return filename.size() >= ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
 void setLogDirectory(const fs::path& dir)
 {
     LOG_DIR = dir;
@@ -27,16 +33,36 @@ fs::path makeLogPath(const std::string& filename)
     return LOG_DIR / extensionJSON(filename);
 }
 
-// ensure correct fileformat
+// binary trace files live next to the json logs.
+fs::path makeTracePath(const std::string& filename)
+{
+    ensureLogDirExists();
+    if (!endsWith(filename, ".trace"))
+    {
+        return LOG_DIR / (filename + ".trace");
+    }
+    return LOG_DIR / filename;
+}
+
+// ensure correct fileformat, .ndjson event logs are kept as they are
 std::string extensionJSON(const std::string& filename)
 {
-    if (filename.size() < 5 || filename.substr(filename.size() - 5) != ".json")
+    if (!endsWith(filename, ".json") && !endsWith(filename, ".ndjson"))
     {
         return filename + ".json";
     }
     return filename;
 }
 
+std::string extensionNDJSON(const std::string& filename)
+{
+    if (!endsWith(filename, ".ndjson"))
+    {
+        return filename + ".ndjson";
+    }
+    return filename;
+}
+
 // Append new JSON object to a JSON array in file
 void appendToJSON_array(const std::string& filename, const json& entry)
 {
@@ -2,50 +2,214 @@
 
 #include <LogsJson.h>
 
+#include <fstream>
+#include <iostream>
+
+//***** LatencyHistograms *****//
+
+void LatencyHistograms::record(const ProcessMetrics& pm)
+{
+    response.record(pm.response_time);
+    waiting.record(pm.waiting_time);
+    turnaround.record(pm.turnaround_time);
+}
+
+void LatencyHistograms::remove(const ProcessMetrics& pm)
+{
+    response.remove(pm.response_time);
+    waiting.remove(pm.waiting_time);
+    turnaround.remove(pm.turnaround_time);
+}
+
+void LatencyHistograms::merge(const LatencyHistograms& other)
+{
+    response.merge(other.response);
+    waiting.merge(other.waiting);
+    turnaround.merge(other.turnaround);
+}
+
+json LatencyHistograms::toJson() const
+{
+    return {{"response time", response.toJson()},
+            {"waiting time", waiting.toJson()},
+            {"turnaround time", turnaround.toJson()}};
+}
+
+static LatencyPercentiles percentilesOf(const LatencyHistogram& h)
+{
+    return {h.percentile(50.0), h.percentile(90.0), h.percentile(99.0), h.percentile(99.9)};
+}
+
+//***** Metrics *****//
+
 Metrics::Metrics(std::vector<PCB>& process_pool)
     : process_pool(process_pool), metrics_calculated(false)
 {
+    reset();
+}
+
+void Metrics::reset()
+{
+    // every slot starts with the process' current values, and is replaced when it completes.
+    cached_metrics.per_process.clear();
+    cached_metrics.per_process.reserve(process_pool.size());
+    for (const auto& proc : process_pool)
+    {
+        cached_metrics.per_process.push_back(calculateProcessMetrics(proc));
+    }
+
+    completed.assign(process_pool.size(), 0);
+    completed_count = 0;
+    total_turnaround_time = 0;
+    total_waiting_time = 0;
+    total_response_time = 0;
+    total_cpu_time = 0;
+    executed_cpu_time = 0;
+    histograms = LatencyHistograms{};
+    priority_histograms.clear();
+    if (windows)
+        windows->clear();
+    metrics_calculated = false;
+}
+
+void Metrics::recordCompletion(size_t idx)
+{
+    ProcessMetrics& slot = cached_metrics.per_process[idx];
+    LatencyHistograms& level = priority_histograms[process_pool[idx].getInitialPriority()];
+
+    // completed again (e.g. a zero time dispatch), replace what was counted before.
+    if (completed[idx])
+    {
+        histograms.remove(slot);
+        level.remove(slot);
+        total_turnaround_time -= slot.turnaround_time;
+        total_waiting_time -= slot.waiting_time;
+        total_response_time -= slot.response_time;
+        total_cpu_time -= slot.cpu_time_used;
+    }
+    else
+    {
+        completed[idx] = 1;
+        completed_count++;
+        if (windows)
+            windows->addCompletion(process_pool[idx].getCompletionTime());
+    }
+
+    slot = calculateProcessMetrics(process_pool[idx]);
+    histograms.record(slot);
+    level.record(slot);
+    total_turnaround_time += slot.turnaround_time;
+    total_waiting_time += slot.waiting_time;
+    total_response_time += slot.response_time;
+    total_cpu_time += slot.cpu_time_used;
+}
+
+void Metrics::recordExecution(long long start, int cpu_time)
+{
+    executed_cpu_time += cpu_time;
+    if (windows)
+    {
+        windows->addDispatch(start);
+        windows->addBusy(start, cpu_time);
+    }
+}
+
+void Metrics::enableWindows(long long window_ticks, size_t capacity)
+{
+    windows.emplace(window_ticks, capacity);
+}
+
+const std::optional<WindowedCounters>& Metrics::getWindows() const
+{
+    return windows;
+}
+
+void Metrics::writeWindowsToFile(const std::string& name, long long end_time) const
+{
+    if (!windows)
+        return;
+
+    std::filesystem::path fullname = makeLogPath(name);
+    std::ofstream out(fullname, std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << fullname << " for writing\n";
+        return;
+    }
+    out << json::array({windows->toJson(end_time)}).dump(4);
 }
 
-SystemMetrics Metrics::calculate(int total_time)
+const SystemMetrics& Metrics::calculate(int total_time)
 {
-    SystemMetrics metrics;
-    // for each process loop through and get the needed characteristics for the
-    // system metrics. add that to the 'metrics' and return that when finished.
-    // set cached_metrics to the metrics before returning the metrics.
+    SystemMetrics& metrics = cached_metrics;
 
     metrics.total_time = total_time;
     metrics.total_processes = process_pool.size();
+    metrics.completed_processes = completed_count;
 
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
-    int total_response_time = 0;
-    int total_cpu_time = 0;
-
-    for (const auto& proc : process_pool)
+    // processes that never completed (e.g. burst 0) count with their current values, like the
+    // full pool scan did. Their slots are refreshed, the running sums are left as they are.
+    long long turnaround = total_turnaround_time;
+    long long waiting = total_waiting_time;
+    long long response = total_response_time;
+    long long cpu = total_cpu_time;
+    if (completed_count < metrics.total_processes)
     {
-        ProcessMetrics pm = calculateProcessMetrics(proc);
-        total_turnaround_time += pm.turnaround_time;
-        total_waiting_time += pm.waiting_time;
-        total_response_time += pm.response_time;
-        total_cpu_time += pm.cpu_time_used;
+        for (size_t idx = 0; idx < process_pool.size(); idx++)
+        {
+            if (completed[idx])
+                continue;
 
-        metrics.per_process.push_back(pm);
+            ProcessMetrics& slot = metrics.per_process[idx];
+            slot = calculateProcessMetrics(process_pool[idx]);
+            turnaround += slot.turnaround_time;
+            waiting += slot.waiting_time;
+            response += slot.response_time;
+            cpu += slot.cpu_time_used;
+        }
     }
 
-    metrics.avg_turnaround_time =
-        static_cast<double>(total_turnaround_time) / metrics.total_processes;
-    metrics.avg_waiting_time = static_cast<double>(total_waiting_time) / metrics.total_processes;
-    metrics.avg_response_time = static_cast<double>(total_response_time) / metrics.total_processes;
-    metrics.cpu_utilization = (static_cast<double>(total_cpu_time) / total_time) * 100;
+    metrics.avg_turnaround_time = static_cast<double>(turnaround) / metrics.total_processes;
+    metrics.avg_waiting_time = static_cast<double>(waiting) / metrics.total_processes;
+    metrics.avg_response_time = static_cast<double>(response) / metrics.total_processes;
+    metrics.cpu_utilization = (static_cast<double>(cpu) / total_time) * 100;
     metrics.throughput = static_cast<double>(metrics.total_processes) / total_time;
+    fillPercentiles(metrics);
 
-    cached_metrics = metrics;
     metrics_calculated = true;
 
     return metrics;
 }
 
+SystemMetrics Metrics::snapshot(int current_time) const
+{
+    SystemMetrics metrics{};
+    metrics.total_time = current_time;
+    metrics.total_processes = process_pool.size();
+    metrics.completed_processes = completed_count;
+
+    if (completed_count > 0)
+    {
+        metrics.avg_turnaround_time = static_cast<double>(total_turnaround_time) / completed_count;
+        metrics.avg_waiting_time = static_cast<double>(total_waiting_time) / completed_count;
+        metrics.avg_response_time = static_cast<double>(total_response_time) / completed_count;
+    }
+    if (current_time > 0)
+    {
+        metrics.cpu_utilization = (static_cast<double>(executed_cpu_time) / current_time) * 100;
+        metrics.throughput = static_cast<double>(completed_count) / current_time;
+    }
+    fillPercentiles(metrics);
+    return metrics;
+}
+
+void Metrics::fillPercentiles(SystemMetrics& metrics) const
+{
+    metrics.response_percentiles = percentilesOf(histograms.response);
+    metrics.waiting_percentiles = percentilesOf(histograms.waiting);
+    metrics.turnaround_percentiles = percentilesOf(histograms.turnaround);
+}
+
 ProcessMetrics Metrics::calculateProcessMetrics(const PCB& proc) const
 {
     // get all the needed metrics from the process do the necessary caluclation
@@ -99,13 +263,28 @@ json Metrics::toJson() const
                                               {"IO time used", pm.io_time_used},
                                               {"Completion time", pm.completion_time}});
     }
+
+    // bucketed distributions, overall and per initial priority
+    summary["latency_histograms"] = {{"overall", histograms.toJson()},
+                                     {"per_priority", json::object()}};
+    for (const auto& [prio, level] : priority_histograms)
+    {
+        summary["latency_histograms"]["per_priority"][std::to_string(prio)] = level.toJson();
+    }
     return summary;
 }
+
+// one array holding the summary, written once instead of createJSON + appendToJSON_array
 void Metrics::writeToFile(const std::string& name) const
 {
-    json summary = toJson();
-    createJSON(name);
-    appendToJSON_array(name, summary);
+    std::filesystem::path fullname = makeLogPath(name);
+    std::ofstream out(fullname, std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << fullname << " for writing\n";
+        return;
+    }
+    out << json::array({toJson()}).dump(4);
 }
 
 // return specific process metrics from pid
@@ -124,6 +303,16 @@ ProcessMetrics Metrics::getProcessMetrics(int pid) const
     }
     throw std::runtime_error("Process not found");
 }
+const LatencyHistograms& Metrics::getHistograms() const
+{
+    return histograms;
+}
+
+const std::map<int, LatencyHistograms>& Metrics::getPriorityHistograms() const
+{
+    return priority_histograms;
+}
+
 double Metrics::getAvgTurnaroundTime() const
 {
     if (!metrics_calculated)
@@ -0,0 +1,152 @@
+#include "MmapTraceWriter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+MmapTraceWriter::MmapTraceWriter(size_t segment_size)
+{
+    // segments start on page boundaries, and hold a whole number of records.
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t pages = (std::max(segment_size, page) + page - 1) / page;
+    this->segment_size = pages * page;
+}
+
+MmapTraceWriter::~MmapTraceWriter()
+{
+    close();
+}
+
+bool MmapTraceWriter::open(const std::filesystem::path& path)
+{
+    close();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        std::cerr << "Could not open: " << path << " for writing\n";
+        return false;
+    }
+
+    records = 0;
+    try
+    {
+        mapSegment(0);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    window_pos = sizeof(TraceHeader);  // the header lives at the start of the first segment
+    writeHeader();
+    return true;
+}
+
+void MmapTraceWriter::write(const TraceRecord& record)
+{
+    if (window == nullptr)
+        return;
+
+    if (window_pos + sizeof(TraceRecord) > segment_size)
+    {
+        mapSegment(segment_index + 1);
+        window_pos = 0;
+    }
+
+    std::memcpy(window + window_pos, &record, sizeof(TraceRecord));
+    window_pos += sizeof(TraceRecord);
+    records++;
+}
+
+void MmapTraceWriter::flush()
+{
+    if (fd < 0)
+        return;
+
+    writeHeader();
+}
+
+void MmapTraceWriter::close()
+{
+    if (fd < 0)
+        return;
+
+    off_t used = static_cast<off_t>(segment_index * segment_size + window_pos);
+    unmap();
+    if (ftruncate(fd, used) != 0)
+    {
+        std::cerr << "Could not truncate trace to " << used << " bytes\n";
+    }
+    writeHeader();
+
+    ::close(fd);
+    fd = -1;
+}
+
+bool MmapTraceWriter::isOpen() const
+{
+    return fd >= 0;
+}
+
+uint64_t MmapTraceWriter::getWrittenRecords() const
+{
+    return records;
+}
+
+size_t MmapTraceWriter::getSegments() const
+{
+    return fd < 0 ? 0 : segment_index + 1;
+}
+
+void MmapTraceWriter::mapSegment(size_t index)
+{
+    unmap();
+
+    off_t offset = static_cast<off_t>(index * segment_size);
+    if (ftruncate(fd, offset + static_cast<off_t>(segment_size)) != 0)
+    {
+        throw std::runtime_error("Could not grow trace file to segment " + std::to_string(index));
+    }
+
+    void* map = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    if (map == MAP_FAILED)
+    {
+        throw std::runtime_error("Could not map trace segment " + std::to_string(index));
+    }
+
+    window = static_cast<char*>(map);
+    segment_index = index;
+}
+
+void MmapTraceWriter::unmap()
+{
+    if (window == nullptr)
+        return;
+
+    munmap(window, segment_size);
+    window = nullptr;
+}
+
+void MmapTraceWriter::writeHeader()
+{
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = records;
+
+    // the first segment may be unmapped by now, a positioned write works either way.
+    if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+    {
+        std::cerr << "Could not write the trace header\n";
+    }
+}
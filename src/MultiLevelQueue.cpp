@@ -0,0 +1,165 @@
+#include "MultiLevelQueue.h"
+
+#include <stdexcept>
+#include <string>
+
+void MultiLevelQueue::resize(int max_priority)
+{
+    // a level is just a head/tail pair, the links are shared by all levels.
+    levels.assign(max_priority + 1, Level{});
+    non_empty.resize(max_priority + 1);
+    for (auto& link : links)
+    {
+        link = Link{};
+    }
+}
+
+void MultiLevelQueue::reserve(size_t processes)
+{
+    if (links.size() < processes)
+    {
+        links.resize(processes);
+    }
+}
+
+void MultiLevelQueue::clear()
+{
+    resize(maxPriority());
+}
+
+void MultiLevelQueue::push(int level, size_t idx)
+{
+    if (idx >= links.size())
+    {
+        links.resize(idx + 1);
+    }
+
+    Link& link = links[idx];
+    if (link.level != NOT_QUEUED)
+    {
+        throw std::runtime_error("Index " + std::to_string(idx) + " is already queued at level " +
+                                 std::to_string(link.level));
+    }
+
+    Level& lvl = levels[level];
+    link.level = level;
+    link.prev = lvl.tail;
+    link.next = NIL;
+
+    if (lvl.tail != NIL)
+        links[lvl.tail].next = idx;
+    else
+        lvl.head = idx;
+
+    lvl.tail = idx;
+    lvl.count++;
+    non_empty.set(level);
+}
+
+size_t MultiLevelQueue::pop(int level)
+{
+    if (empty(level))
+    {
+        throw std::runtime_error("Queue empty");
+    }
+
+    size_t idx = levels[level].head;
+    unlink(idx);
+    return idx;
+}
+
+bool MultiLevelQueue::remove(int level, size_t idx)
+{
+    if (!contains(level, idx))
+    {
+        return false;
+    }
+
+    unlink(idx);
+    return true;
+}
+
+void MultiLevelQueue::unlink(size_t idx)
+{
+    Link& link = links[idx];
+    Level& lvl = levels[link.level];
+
+    if (link.prev != NIL)
+        links[link.prev].next = link.next;
+    else
+        lvl.head = link.next;
+
+    if (link.next != NIL)
+        links[link.next].prev = link.prev;
+    else
+        lvl.tail = link.prev;
+
+    lvl.count--;
+    if (lvl.count == 0)
+    {
+        non_empty.clear(link.level);
+    }
+
+    link = Link{};
+}
+
+bool MultiLevelQueue::contains(int level, size_t idx) const
+{
+    return idx < links.size() && links[idx].level == level;
+}
+
+bool MultiLevelQueue::empty(int level) const
+{
+    return levels[level].count == 0;
+}
+
+bool MultiLevelQueue::empty() const
+{
+    return !non_empty.any();
+}
+
+size_t MultiLevelQueue::size(int level) const
+{
+    return levels[level].count;
+}
+
+size_t MultiLevelQueue::front(int level) const
+{
+    if (empty(level))
+    {
+        throw std::runtime_error("Queue empty");
+    }
+    return levels[level].head;
+}
+
+int MultiLevelQueue::levelOf(size_t idx) const
+{
+    return idx < links.size() ? links[idx].level : NOT_QUEUED;
+}
+
+int MultiLevelQueue::highestLevel() const
+{
+    return non_empty.findFirst();
+}
+
+int MultiLevelQueue::nextLevel(int level) const
+{
+    return non_empty.findNext(level);
+}
+
+int MultiLevelQueue::maxPriority() const
+{
+    return static_cast<int>(levels.size()) - 1;
+}
+
+std::vector<size_t> MultiLevelQueue::toVector(int level) const
+{
+    std::vector<size_t> vec;
+    vec.reserve(levels[level].count);
+
+    for (size_t idx = levels[level].head; idx != NIL; idx = links[idx].next)
+    {
+        vec.push_back(idx);
+    }
+    return vec;
+}
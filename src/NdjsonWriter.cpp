@@ -0,0 +1,109 @@
+#include "NdjsonWriter.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+NdjsonWriter::NdjsonWriter(size_t buffer_size) : buffer_size(buffer_size)
+{
+}
+
+void NdjsonWriter::setCap(size_t max_events_, size_t max_bytes)
+{
+    if (max_events_ == 0 && max_bytes == 0)
+        max_bytes = DEFAULT_BUFFER_SIZE;
+
+    this->max_events = max_events_;
+    this->buffer_size = max_bytes == 0 ? std::numeric_limits<size_t>::max() : max_bytes;
+}
+
+NdjsonWriter::~NdjsonWriter()
+{
+    close();
+}
+
+bool NdjsonWriter::open(const std::filesystem::path& path)
+{
+    close();
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << path << " for writing\n";
+        return false;
+    }
+
+    buffer.clear();
+    buffered_events = 0;
+    written_events = 0;
+    spills = 0;
+    peak_buffered_bytes = 0;
+    return true;
+}
+
+void NdjsonWriter::write(const json& entry)
+{
+    if (!out.is_open())
+        return;
+
+    buffer += entry.dump();  // compact, a single line
+    buffer += '\n';
+    buffered_events++;
+    written_events++;
+    peak_buffered_bytes = std::max(peak_buffered_bytes, buffer.size());
+
+    // cap reached, spill the batch to the file and keep going.
+    if (buffer.size() >= buffer_size || (max_events != 0 && buffered_events >= max_events))
+    {
+        spills++;
+        flush();
+    }
+}
+
+void NdjsonWriter::flush()
+{
+    if (!out.is_open())
+        return;
+
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        buffered_events = 0;
+    }
+    out.flush();
+}
+
+void NdjsonWriter::close()
+{
+    if (!out.is_open())
+        return;
+
+    flush();
+    out.close();
+}
+
+bool NdjsonWriter::isOpen() const
+{
+    return out.is_open();
+}
+
+size_t NdjsonWriter::getWrittenEvents() const
+{
+    return written_events;
+}
+
+size_t NdjsonWriter::getBufferedBytes() const
+{
+    return buffer.size();
+}
+
+size_t NdjsonWriter::getSpills() const
+{
+    return spills;
+}
+
+size_t NdjsonWriter::getPeakBufferedBytes() const
+{
+    return peak_buffered_bytes;
+}
@@ -12,6 +12,7 @@ PCB::PCB(int pid,
     : pid(pid), prio(prio), burst_time(burst), io_bound(io_bound), io_interval(io_interval)
 {
     this->old_prio = prio;
+    this->initial_prio = prio;
     this->remaining_time = burst;
     this->waiting_time = 0;
     this->io_remaining = 0;
@@ -62,7 +63,7 @@ bool PCB::ageProcess(int timediff)
     waiting_time += timediff;
 
     // Aging threshold proportional with time quantum. (5 * 4)
-    if (waiting_time >= pcb_aging_t * pcb_time_q && prio > 1)
+    if (waiting_time >= getAgingLimit() && prio > 1)
     {
         old_prio = prio;
         prio--;
@@ -107,6 +108,11 @@ int PCB::getOldPriority() const
     return old_prio;
 }
 
+int PCB::getInitialPriority() const
+{
+    return initial_prio;
+}
+
 int PCB::getBurstTime() const
 {
     return burst_time;
@@ -157,6 +163,12 @@ int PCB::getFirstResponseTime() const
     return first_response_time;
 }
 
+// waiting time that triggers a promotion, proportional with time quantum.
+int PCB::getAgingLimit() const
+{
+    return pcb_aging_t * pcb_time_q;
+}
+
 ProcessState PCB::getState() const
 {
     return PS;
@@ -164,7 +176,12 @@ ProcessState PCB::getState() const
 
 std::string PCB::getStringState() const
 {
-    switch (PS)
+    return stateToString(PS);
+}
+
+const char* PCB::stateToString(ProcessState state)
+{
+    switch (state)
     {
         case ProcessState::READY:
             return "READY";
@@ -204,6 +221,27 @@ void PCB::setPriority(int prio_)
     this->prio = prio_;
 }
 
+void PCB::promoteTo(int prio_)
+{
+    this->old_prio = prio;
+    this->prio = prio_;
+}
+
+void PCB::setRemainingTime(int time)
+{
+    this->remaining_time = time;
+}
+
+void PCB::setWaitingTime(int time)
+{
+    this->waiting_time = time;
+}
+
+void PCB::setTotalIOTime(int time)
+{
+    this->total_io_time = time;
+}
+
 void PCB::recordFirstResponse(int time)
 {
     this->first_response = true;
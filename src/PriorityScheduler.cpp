@@ -3,13 +3,16 @@
 #include "LogsJson.h"
 #include "SchedulerClass.h"
 
-int main()
+// PriorityScheduler [config], a json config or a compiled .workload (tools/compile_workload.cpp)
+int main(int argc, char** argv)
 {
     auto exe_path = std::filesystem::current_path();
     setLogDirectory(exe_path / "logs");
 
     // make use of the /= operator, for portability to other platforms.
     auto config_path = std::filesystem::current_path() / "config" / "process_config.json";
+    if (argc > 1)
+        config_path = std::filesystem::absolute(argv[1]);
 
     if (!std::filesystem::exists(config_path))
     {
@@ -20,6 +23,9 @@ int main()
     Scheduler scheduler("proces_logs", config_path.string());
 
     scheduler.setDebugFlags(Scheduler::ALL);
+    scheduler.enableDebugSink();  // buffered, drained to stdout in the background
+    scheduler.enableWindowedMetrics();
+    scheduler.enableQueueStats();
 
     std::thread t1([&scheduler]() { scheduler.run(); });
 
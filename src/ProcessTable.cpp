@@ -0,0 +1,101 @@
+#include "ProcessTable.h"
+
+#include "SimdKernels.h"
+
+ProcessTable::ProcessTable(std::vector<PCB>& process_pool) : process_pool(process_pool)
+{
+    gather();
+}
+
+void ProcessTable::gather()
+{
+    const size_t n = process_pool.size();
+    remaining_time.resize(n);
+    prio.resize(n);
+    waiting_time.resize(n);
+    io_remaining.resize(n);
+    state.resize(n);
+    aging_limit.resize(n);
+    total_io_time.resize(n);
+
+    for (size_t idx = 0; idx < n; idx++)
+    {
+        gather(idx);
+    }
+}
+
+void ProcessTable::gather(size_t idx)
+{
+    const PCB& p = process_pool[idx];
+    remaining_time[idx] = p.getRemainingTime();
+    prio[idx] = p.getPriority();
+    waiting_time[idx] = p.getWaitingTime();
+    io_remaining[idx] = p.getIORemainingTime();
+    state[idx] = p.getState();
+    aging_limit[idx] = p.getAgingLimit();
+    total_io_time[idx] = p.getTotalIOTime();
+}
+
+void ProcessTable::scatter()
+{
+    for (size_t idx = 0; idx < size(); idx++)
+    {
+        scatter(idx);
+    }
+}
+
+void ProcessTable::scatter(size_t idx)
+{
+    PCB& p = process_pool[idx];
+
+    // a changed priority is a promotion, keep the previous one like PCB::ageProcess does.
+    if (p.getPriority() != prio[idx])
+    {
+        p.promoteTo(prio[idx]);
+    }
+    p.setRemainingTime(remaining_time[idx]);
+    p.setWaitingTime(waiting_time[idx]);
+    p.setIOTime(io_remaining[idx]);
+    p.setState(state[idx]);
+    p.setTotalIOTime(total_io_time[idx]);
+}
+
+PCB& ProcessTable::pcb(size_t idx)
+{
+    scatter(idx);
+    return process_pool[idx];
+}
+
+const std::vector<size_t>& ProcessTable::ageReady(int delta, size_t skip)
+{
+    changed.resize(size());
+    size_t count = ageKernel(waiting_time.data(),
+                             prio.data(),
+                             state.data(),
+                             aging_limit.data(),
+                             size(),
+                             delta,
+                             skip,
+                             changed.data());
+    changed.resize(count);
+    return changed;
+}
+
+const std::vector<size_t>& ProcessTable::advanceIO(int delta)
+{
+    changed.resize(size());
+    size_t count = ioCountdownKernel(io_remaining.data(),
+                                     total_io_time.data(),
+                                     waiting_time.data(),
+                                     state.data(),
+                                     size(),
+                                     delta,
+                                     changed.data());
+    changed.resize(count);
+    return changed;
+}
+
+size_t ProcessTable::size() const
+{
+    return remaining_time.size();
+}
@@ -0,0 +1,104 @@
+#include "QueueStats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "LogsJson.h"
+
+QueueStats::QueueStats(int max_priority, size_t processes)
+    : levels(static_cast<size_t>(std::max(0, max_priority)) + 1), enqueued_at(processes, 0)
+{
+}
+
+void QueueStats::onEnqueue(int level, size_t idx, long long now)
+{
+    LevelQueueStats& stats = levels[level];
+    stats.enqueues++;
+    setDepth(stats, stats.depth + 1, now);
+    stats.max_depth = std::max(stats.max_depth, stats.depth);
+    enqueued_at[idx] = now;
+}
+
+void QueueStats::onDequeue(int level, size_t idx, long long now)
+{
+    levels[level].dequeues++;
+    leave(level, idx, now);
+}
+
+void QueueStats::onPromotion(int level, size_t idx, long long now)
+{
+    levels[level].promotions++;
+    leave(level, idx, now);
+}
+
+int QueueStats::getMaxPriority() const
+{
+    return static_cast<int>(levels.size()) - 1;
+}
+
+const LevelQueueStats& QueueStats::getLevel(int level) const
+{
+    return levels.at(level);
+}
+
+double QueueStats::getAverageDepth(int level, long long now) const
+{
+    const LevelQueueStats& stats = levels.at(level);
+    if (now <= 0)
+        return static_cast<double>(stats.depth);
+
+    long double area = stats.depth_area + static_cast<long double>(stats.depth) *
+                                              std::max(0LL, now - stats.last_change);
+    return static_cast<double>(area / now);
+}
+
+json QueueStats::toJson(long long now) const
+{
+    json out = json::array();
+    for (int level = 1; level <= getMaxPriority(); level++)
+    {
+        const LevelQueueStats& stats = levels[level];
+        if (stats.enqueues == 0)
+            continue;
+
+        out.push_back({{"level", level},
+                       {"enqueues", stats.enqueues},
+                       {"dequeues", stats.dequeues},
+                       {"promotions", stats.promotions},
+                       {"max depth", stats.max_depth},
+                       {"average depth", getAverageDepth(level, now)},
+                       {"wait time", stats.wait.toJson()}});
+    }
+    return out;
+}
+
+void QueueStats::writeToFile(const std::string& name, long long now) const
+{
+    std::filesystem::path fullname = makeLogPath(name);
+    std::ofstream out(fullname, std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << fullname << " for writing\n";
+        return;
+    }
+    out << json::array({toJson(now)}).dump(4);
+}
+
+void QueueStats::leave(int level, size_t idx, long long now)
+{
+    LevelQueueStats& stats = levels[level];
+    setDepth(stats, stats.depth > 0 ? stats.depth - 1 : 0, now);
+    stats.wait.record(now - enqueued_at[idx]);
+}
+
+// closes the time integral of the old depth before changing it
+void QueueStats::setDepth(LevelQueueStats& stats, size_t depth, long long now)
+{
+    if (now > stats.last_change)
+    {
+        stats.depth_area += static_cast<long double>(stats.depth) * (now - stats.last_change);
+        stats.last_change = now;
+    }
+    stats.depth = depth;
+}
@@ -1,15 +1,21 @@
 #include "SchedulerClass.h"
 
+#include <algorithm>
 #include <format>
-#include <ranges>
 #include <sstream>
+#include <stdexcept>
 
-Scheduler::Scheduler(std::string logs_name, std::string config_file)
-    : logs_name(logs_name), config_file(config_file), loader(config_file)
+Scheduler::Scheduler(std::string logs_name, std::string config_file, LogFormat log_format)
+    : logs_name(logs_name), log_format(log_format), config_file(config_file), loader(config_file)
 {
     loadConfig(config_file);
     this->logs_name = std::filesystem::path(logs_name).stem().string();
-    createJSON(logs_name);
+    if (log_format == LogFormat::BINARY)
+        traceLog.open(makeTracePath(this->logs_name));
+    else if (log_format == LogFormat::BINARY_MMAP)
+        mmapLog.open(makeTracePath(this->logs_name));
+    else
+        eventLog.open(makeLogPath(extensionNDJSON(this->logs_name)));
 }
 
 void Scheduler::loadConfig(std::string config_file)
@@ -20,34 +26,33 @@ void Scheduler::loadConfig(std::string config_file)
     max_priority_sched = sched_conf.max_priority;
     context_switch_time_sched = sched_conf.context_switch_time;
 
-    readyQueue.resize(max_priority_sched +
-                      1);  // after getting the max_priority value, resize the container.
-
-    proc_conf = loader.getProcessConfig();
-    if (proc_conf.size() > MAX_PROCESS_SIZE)
-    {
-        throw std::runtime_error("To many processes, the maximum size is: " +
-                                 std::to_string(MAX_PROCESS_SIZE));
-    }
-
     process_pool.clear();
-    process_pool.reserve(proc_conf.size());  // optional, but avoids re-allocs.
+    process_pool.reserve(loader.getProcessCount());  // optional, but avoids re-allocs.
 
-    for (const auto& pc : proc_conf)
-    {
-        process_pool.emplace_back(pc.pid,
-                                  pc.priority,
-                                  pc.burst,
-                                  pc.io_bound,
-                                  pc.io_interval,
-                                  aging_threshold_sched,
-                                  time_quantum_sched);
-    }
+    // straight from the loader's list, or from the mapping of a compiled workload
+    loader.forEachProcess(
+        [this](const ProcessConfig& pc)
+        {
+            process_pool.emplace_back(pc.pid,
+                                      pc.priority,
+                                      pc.burst,
+                                      pc.io_bound,
+                                      pc.io_interval,
+                                      aging_threshold_sched,
+                                      time_quantum_sched);
+        });
+
+    // after getting the max_priority value and the pool size, size the ready queues.
+    readyQueue.resize(max_priority_sched);
+    readyQueue.reserve(process_pool.size());
 
     // lazy initialization with std::optional,
     // used because the values loading, isnt known before this point.
     IO_Processes.emplace(process_pool);
+    aging.emplace(process_pool);
     metrics.emplace(process_pool);
+
+    setLogPolicy(sched_conf.log_policy);
 }
 
 void Scheduler::priorityScheduling()
@@ -55,319 +60,522 @@ void Scheduler::priorityScheduling()
     // sort the process pool, by lowest priority first, by using ranges with projections
     std::ranges::sort(process_pool, std::ranges::less{}, &PCB::getPriority);
 
-    debug(EXEC, "Process order");
+    debug<EXEC>("Process order");
     for (const auto& proc : process_pool)
     {
-        debug(EXEC,
-              std::format("PID: {}, Burst Time: {}, Priority: {}",
-                          proc.getPid(),
-                          proc.getBurstTime(),
-                          proc.getPriority()));
+        debug<EXEC>(
+            [&]()
+            {
+                return std::format("PID: {}, Burst Time: {}, Priority: {}",
+                                   proc.getPid(),
+                                   proc.getBurstTime(),
+                                   proc.getPriority());
+            });
     }
-    debug(EXEC,
-          std::format(
-              "Time Quantum: {}, Max Priority: {}, Aging Threshold: {}, Context Switch Time: {}",
-              time_quantum_sched,
-              max_priority_sched,
-              aging_threshold_sched,
-              context_switch_time_sched));
+    debug<EXEC>(
+        [&]()
+        {
+            return std::format(
+                "Time Quantum: {}, Max Priority: {}, Aging Threshold: {}, Context Switch Time: {}",
+                time_quantum_sched,
+                max_priority_sched,
+                aging_threshold_sched,
+                context_switch_time_sched);
+        });
 }
 
-void Scheduler::updateQueuesAfterAging(PCB* p, int& time_slice)
+void Scheduler::updateQueuesAfterAging(size_t idx, int time_slice)
 {
     //***** Update aging *****//
-    // phase 1 - find aged processes, and store them in vector
-    /* clang-format off
-    std::vector<size_t> aged_processes;
-    for (size_t idx = 0; idx < process_pool.size(); idx++)
+    /*
+    Every queued process, except the one just executed, waits for time_slice.
+    The aging engine does that lazily with an aging clock and a deadline heap, so only the processes
+    that actually reach the aging threshold are touched here. Same result as calling
+    PCB::ageProcess(time_slice) on every waiting process in the pool.
+    */
+    const auto& promoted = aging->advance(time_slice, idx);
+
+    // the promoted processes are moved to their new level in index order, before the next dispatch.
+    for (size_t id : promoted)
     {
-        if (process_pool[idx].getRemainingTime() > 0 && 
-            process_pool[idx].getPid() != p->getPid() && 
-            !process_pool[idx].isWaitingIO() && 
-            readyQueue[process_pool[idx].getPriority()].contains(idx))
-        {
-            if (process_pool[idx].ageProcess(time_slice))
-            {
-                aged_processes.push_back(idx);
-            }
-        }
+        calendar.schedule(currentTime, EventType::AGING_PROMOTION, id);
     }
+}
 
-    // phase 2 - remove and push the aged processes, to appropriate queues.
-    for (auto id : aged_processes)
+// the log policy masks (ConfigLoader.h) are one bit per TraceEvent
+static_assert(LOG_EVENT_RUNNING == 1u << static_cast<unsigned>(TraceEvent::RUNNING));
+static_assert(LOG_EVENT_IO_WAIT == 1u << static_cast<unsigned>(TraceEvent::IO_WAIT));
+static_assert(LOG_EVENT_FINISHED == 1u << static_cast<unsigned>(TraceEvent::FINISHED));
+
+void Scheduler::logEvent(size_t idx)
+{
+    if (idx >= process_pool.size())
     {
-        readyQueue[process_pool[id].getOldPriority()].remove(id);
-        readyQueue[process_pool[id].getPriority()].push(id);
+        throw std::out_of_range("logEvent: no process at index " + std::to_string(idx));
     }
-    */
 
-    // clang-format off
-    
-    /*
-    The above style is the clearly favored style, because it is way easier to understand. There is a lof of nested conditionals, 
-    and modifications during the loops, therefore ranges and views, should probably not be prefered. 
-    It is though, because i wanted to practice them. Therefore the above, out-commented code is kept. 
-    */
+    const PCB* p = &process_pool[idx];
+    TraceEvent event = TraceEvent::RUNNING;
+    if (p->getRemainingTime() == 0)
+        event = TraceEvent::FINISHED;
+    else if (p->isWaitingIO())
+        event = TraceEvent::IO_WAIT;
+    else
+        event = TraceEvent::RUNNING;
 
-    std::vector<size_t> aged_processes;
-    
-    //  First use std::views with iota, for iterating over all the processes in the pool, and do the necessary checks. 
-    auto idx_range = std::views::iota((size_t)0, process_pool.size())  |  
-    std::views::filter([&](size_t idx){PCB& proc = process_pool[idx]; 
-        return proc.getRemainingTime() > 0 && 
-        (proc.getPid() != p->getPid()) && 
-        !proc.isWaitingIO() && 
-        readyQueue[proc.getPriority()].contains(idx); });
+    //***** Log policy *****//
+    // event type and pid allowlist are folded into one mask per process, a filtered event is a
+    // single test before any record is built.
+    uint8_t event_bit = static_cast<uint8_t>(1 << static_cast<uint8_t>(event));
+    if ((log_event_masks[idx] & event_bit) == 0)
+        return;
 
-    // For the processes ful-filling the previous conditionals, use ranges to iterate over each and age. 
-    std::ranges::for_each(idx_range, ([&] (size_t idx) {
-        if(process_pool[idx].ageProcess(time_slice))
-            aged_processes.push_back(idx);}));
+    if (log_policy.transitions_only)
+    {
+        if (log_last_event[idx] == event_bit)
+            return;
+        log_last_event[idx] = event_bit;
+    }
 
-    // Use ranges on each element that fulfilled previous conditionals, to update their priority. 
-    std::ranges::for_each(aged_processes, [&](size_t idx) {
-        readyQueue[process_pool[idx].getOldPriority()].remove(idx);
-        readyQueue[process_pool[idx].getPriority()].push(idx);
-    });
+    if (log_policy.sample_every > 1 && ++log_sample_count % log_policy.sample_every != 0)
+        return;
 
-    // clang-format on
+    // fixed size record, the json layout is only built for the NDJSON log.
+    TraceRecord record = makeTraceRecord(*p, event, currentTime);
+    if (asyncLog)
+        asyncLog->write(record);
+    else
+        writeRecords(&record, 1);
 }
 
-void Scheduler::logEvent(PCB* p)
+void Scheduler::writeRecords(const TraceRecord* records, size_t count)
 {
-    enum class Event
+    for (size_t i = 0; i < count; i++)
     {
-        RUNNING,
-        IO_WAIT,
-        FINISHED
-    };
+        if (log_format == LogFormat::BINARY)
+            traceLog.write(records[i]);
+        else if (log_format == LogFormat::BINARY_MMAP)
+            mmapLog.write(records[i]);
+        else
+            eventLog.write(traceRecordToJson(records[i]));
+    }
+}
 
-    Event event = Event::RUNNING;
-    if (p->getRemainingTime() == 0)
-        event = Event::FINISHED;
-    else if (p->isWaitingIO())
-        event = Event::IO_WAIT;
-    else
-        event = Event::RUNNING;
+void Scheduler::flushLogs()
+{
+    // written on the simulation thread, with or without async logging
+    timeline.flush();
+
+    if (asyncLog)
+    {
+        asyncLog->flush();  // the event log writers are flushed on the writer thread
+
+        AsyncLogStats stats = asyncLog->getStats();
+        debug<EXEC>(
+            [&]()
+            {
+                return std::format(
+                    "Async log: {} records in {} batches, producer waited {} times ({} us)",
+                    stats.records,
+                    stats.batches,
+                    stats.producer_waits,
+                    stats.producer_wait_ns / 1000);
+            });
+        return;
+    }
 
-    json j_array = {{"pid", p->getPid()},
-                    {"prio", p->getPriority()},
-                    {"event", event},
-                    {"waiting time", p->getWaitingTime()},
-                    {"remaining time", p->getRemainingTime()},
-                    {"io bound", p->isIOBound()},
-                    {"io interval", p->getIOInterval()},
-                    {"CPU used", p->getCpuUsed()},
-                    {"Process State", p->getStringState()}};
+    eventLog.flush();
+    traceLog.flush();
+    mmapLog.flush();
+}
 
-    eventLog.push_back(j_array);
+void Scheduler::enableChromeTrace()
+{
+    timeline.open(makeLogPath(logs_name + "_timeline"));
 }
 
-void Scheduler::flushLogs()
+void Scheduler::setLogPolicy(const LogPolicy& policy)
+{
+    log_policy = policy;
+    if (log_policy.sample_every < 1)
+        log_policy.sample_every = 1;
+    resetLogFilter();
+}
+
+const LogPolicy& Scheduler::getLogPolicy() const
 {
-    for (auto& e : eventLog)
+    return log_policy;
+}
+
+void Scheduler::resetLogFilter()
+{
+    uint8_t mask = static_cast<uint8_t>(log_policy.event_mask & LOG_EVENT_ALL);
+
+    log_event_masks.assign(process_pool.size(), mask);
+    if (!log_policy.pids.empty())
     {
-        appendToJSON_array(logs_name, e);
+        std::vector<int> allowed = log_policy.pids;
+        std::ranges::sort(allowed);
+        for (size_t idx = 0; idx < process_pool.size(); idx++)
+        {
+            if (!std::ranges::binary_search(allowed, process_pool[idx].getPid()))
+                log_event_masks[idx] = 0;
+        }
     }
+
+    log_last_event.assign(process_pool.size(), 0);
+    log_sample_count = 0;
 }
 
-bool Scheduler::cleanUpQueues(int& currentTime, int& lastTime)
+void Scheduler::setLogMemoryCap(size_t max_events, size_t max_bytes)
 {
-    // Check if all work is done.
-    bool hasRemainingWork =
-        std::ranges::any_of(process_pool, [](const PCB& p) { return p.getRemainingTime() > 0; });
+    eventLog.setCap(max_events, max_bytes);
 
-    // If this condition is met, all processes done.
-    if (!hasRemainingWork && IO_Processes->isEmpty())
+    // fixed size records, the byte cap is a record cap for the binary trace.
+    size_t max_records = max_events;
+    if (max_bytes != 0)
     {
-        lastTime = currentTime;
-        return false;
+        size_t byte_records = std::max<size_t>(1, max_bytes / sizeof(TraceRecord));
+        max_records = max_records == 0 ? byte_records : std::min(max_records, byte_records);
     }
+    traceLog.setCap(max_records);
+}
+
+size_t Scheduler::getLogSpills() const
+{
+    return eventLog.getSpills() + traceLog.getSpills();
+}
+
+void Scheduler::enableAsyncLogging(size_t batch_records, size_t batch_count)
+{
+    // from here on only the writer thread touches eventLog / traceLog.
+    asyncLog.emplace([this](const TraceRecord* records, size_t count)
+                     { writeRecords(records, count); },
+                     [this]()
+                     {
+                         eventLog.flush();
+                         traceLog.flush();
+                         mmapLog.flush();
+                     },
+                     batch_records,
+                     batch_count);
+}
+
+std::optional<AsyncLogStats> Scheduler::getAsyncLogStats() const
+{
+    if (!asyncLog)
+        return std::nullopt;
 
-    // Check if Ready Queue has processes to process. Remember to skip first element (priority = 0).
-    bool anyQueueHasWork = std::ranges::any_of(readyQueue | std::views::drop(1),
-                                               [](const auto& q) { return !q.empty(); });
+    return asyncLog->getStats();
+}
+
+void Scheduler::roundRobin()
+{
+    aging->reset();
+    calendar.clear();
+    unfinished_processes = 0;
+    resetLogFilter();  // the pool may have been reordered since loadConfig
+    metrics->reset();
+    if (queueStats)
+        queueStats.emplace(max_priority_sched, process_pool.size());
 
-    // If all processes are in IO wait, advance time
-    if (!anyQueueHasWork && !IO_Processes->isEmpty())
+    for (size_t p = 0; p < process_pool.size(); p++)
     {
-        // Find minimum IO remaining time
-        int minTime = IO_Processes->getMinRemainingIOTime();
-        debug(QUEUE, std::format("All processes in IO wait, advancing time by {}", minTime));
-        currentTime += minTime;
+        if (process_pool[p].getRemainingTime() > 0)
+            unfinished_processes++;
 
-        // Process IO completions
-        IO_Processes->processIO(minTime);
+        // all processes arrive at 0.
+        calendar.schedule(0, EventType::ARRIVAL, p);
+    }
 
-        // Hold finished processes, and reinsert back to ready queue.
-        const auto& finished = IO_Processes->getFinishedProcesses();
-        for (auto idx : finished)
+    currentTime = 0;  // track current time
+    lastTime = 0;
+
+    /*
+    Discrete event loop. Time jumps straight to the next event in the calendar, and the CPU is only
+    dispatched when every event up to now has been handled. With no ready process, the next IO
+    completion is the next event.
+    */
+    while (true)
+    {
+        if (!calendar.empty())
         {
-            PCB& proc = process_pool[idx];
-            if (proc.getRemainingTime() > 0)
-            {
-                debug(QUEUE,
-                      std::format("[IO DONE] PID: {}, resuming from IO at total time {}",
-                                  proc.getPid(),
-                                  currentTime));
-                readyQueue[proc.getPriority()].push(idx);
-            }
+            Event ev = calendar.pop();
+            currentTime = static_cast<int>(ev.time);
+            handleEvent(ev);
+            lastTime = currentTime;
+            continue;
         }
 
-        if (!finished.empty())
+        // If this condition is met, all processes done.
+        if (unfinished_processes == 0 && IO_Processes->isEmpty())
         {
-            IO_Processes->clearFinished();
+            break;
         }
 
-        lastTime = currentTime;
+        if (!readyQueue.empty())
+        {
+            dispatchNext();
+        }
+        else if (!advanceToNextIOCompletion())
+        {
+            break;  // nothing ready, nothing in IO, nothing left that can run.
+        }
+    }
 
-        return true;
+    // when finished write all to logs.
+    debug<EXEC>("Flushing logs");
+    flushLogs();
+}
+
+void Scheduler::handleEvent(const Event& ev)
+{
+    switch (ev.type)
+    {
+        case EventType::ARRIVAL:
+            onArrival(ev.idx);
+            break;
+        case EventType::IO_COMPLETION:
+            onIOCompletion(ev.idx);
+            break;
+        case EventType::QUANTUM_EXPIRY:
+            onQuantumExpiry(ev.idx);
+            break;
+        case EventType::AGING_PROMOTION:
+            onAgingPromotion(ev.idx);
+            break;
     }
-    return true;
 }
 
-void Scheduler::roundRobin()
+void Scheduler::onArrival(size_t idx)
 {
-    for (size_t p = 0; p < process_pool.size(); p++)
+    PCB& proc = process_pool[idx];
+    if (proc.getPriority() < 1 || proc.getPriority() > max_priority_sched)  // use clamp!
     {
-        if (process_pool[p].getPriority() < 0 ||
-            process_pool[p].getPriority() > max_priority_sched)  // use clamp!
-        {
-            process_pool[p].setPriority(
-                std::clamp(process_pool[p].getPriority(), 1, max_priority_sched));
-            debug(WARNING, "Clamping prio - otherwise out of index");
-        }
-        readyQueue[process_pool[p].getPriority()].push(p);
+        proc.setPriority(std::clamp(proc.getPriority(), 1, max_priority_sched));
+        debug<WARNING>("Clamping prio - otherwise out of index");
     }
+    pushReady(proc.getPriority(), idx);
+}
 
-    currentTime = 0;  // track current time
-    int lastTime = 0;
+void Scheduler::onIOCompletion(size_t idx)
+{
+    PCB& proc = process_pool[idx];
+    if (timeline.isOpen())
+        timeline.ioEnd(0, proc.getPid(), currentTime);
 
-    while (true)
+    if (proc.getRemainingTime() > 0 && proc.isReady())
+    {
+        debug<QUEUE>(
+            [&]()
+            {
+                return std::format("[IO DONE] PID: {}, resuming from IO at total time {}",
+                                   proc.getPid(),
+                                   currentTime);
+            });
+        pushReady(proc.getPriority(), idx);
+    }
+}
+
+void Scheduler::onAgingPromotion(size_t idx)
+{
+    // the aging engine already lowered the priority, move it to the new level.
+    PCB& proc = process_pool[idx];
+    removeReady(proc.getOldPriority(), idx);
+    pushReady(proc.getPriority(), idx);
+    debug<AGING>(
+        [&]()
+        {
+            return std::format("[AGING] PID: {} promoted from priority {} to {}",
+                               proc.getPid(),
+                               proc.getOldPriority(),
+                               proc.getPriority());
+        });
+}
+
+// Nothing ready to run: jump to the time where the first IO finishes.
+bool Scheduler::advanceToNextIOCompletion()
+{
+    if (IO_Processes->isEmpty())
     {
-        if (!cleanUpQueues(currentTime, lastTime))
+        return false;
+    }
+
+    // Find minimum IO remaining time
+    int minTime = IO_Processes->getMinRemainingIOTime();
+    debug<QUEUE>(
+        [&]()
         {
-            break;
-        }
-        // Execute process
-        for (auto el = 1; el <= max_priority_sched; ++el)
+            return std::format("All processes in IO wait, advancing time by {}", minTime);
+        });
+
+    // Process IO completions
+    IO_Processes->processIO(minTime);
+
+    // Hold finished processes, and reinsert back to ready queue when the event is handled.
+    const auto& finished = IO_Processes->getFinishedProcesses();
+    for (size_t idx : finished)
+    {
+        calendar.schedule(currentTime + minTime, EventType::IO_COMPLETION, idx);
+    }
+
+    if (!finished.empty())
+    {
+        IO_Processes->clearFinished();
+    }
+    else
+    {
+        // time still passed, even without a completion.
+        currentTime += minTime;
+        lastTime = currentTime;
+    }
+
+    return true;
+}
+
+void Scheduler::dispatchNext()
+{
+    // Highest priority level with work, straight from the non-empty bitmap.
+    int el = readyQueue.highestLevel();
+
+    debug<QUEUE>(
+        [&]()
         {
-            if (!readyQueue[el].empty())
+            std::ostringstream oss;
+            // Ready queues
+
+            // only the non-empty levels, there can be thousands of levels.
+            for (int prio = readyQueue.highestLevel(); prio != PriorityBitmap::NO_LEVEL;
+                 prio = readyQueue.nextLevel(prio))
             {
-                debug(QUEUE,
-                      [&]()
-                      {
-                          std::ostringstream oss;
-                          // Ready queues
-
-                          for (int prio = 1; prio <= max_priority_sched; ++prio)
-                          {
-                              oss << "Priority: " << prio << " contains: ";
-                              for (size_t idx : readyQueue[prio].toVector())
-                              {
-                                  oss << "PID: " << process_pool[idx].getPid() << " ";
-                              }
-                              oss << "\n";
-                          }
-                          oss << "\n========================\n";
-                          // IO queue
-                          oss << "IO wait queue: ";
-
-                          for (size_t idx : IO_Processes->getQueue())
-                          {
-                              oss << "PID: " << process_pool[idx].getPid() << " ";
-                          }
-
-                          oss << "\n========================\n";
-                          oss << "IO wait queue size: " << IO_Processes->size();
-
-                          return oss.str();
-                      });
-
-                size_t i = readyQueue[el].pop();
-
-                PCB& p = process_pool[i];
-
-                //***** check if context switch *****//
-                if (lastProcess.has_value() && p.getPid() != lastProcess->getPid())
+                oss << "Priority: " << prio << " contains: ";
+                for (size_t idx : readyQueue.toVector(prio))
                 {
-                    currentTime += context_switch_time_sched;  // increment with context switch
+                    oss << "PID: " << process_pool[idx].getPid() << " ";
                 }
+                oss << "\n";
+            }
+            oss << "\n========================\n";
+            // IO queue
+            oss << "IO wait queue: ";
 
-                //***** calculate time delta *****//
-                int delta = currentTime - lastTime;
+            for (size_t idx : IO_Processes->getQueue())
+            {
+                oss << "PID: " << process_pool[idx].getPid() << " ";
+            }
 
-                //***** IO Wait Queue management *****//
-                // want to process IO first, for alredy waiting processes
-                if (delta > 0)
-                {
-                    IO_Processes->processIO(delta);
-
-                    // move finished IO processes
-                    const auto& finished = IO_Processes->getFinishedProcesses();
-                    for (size_t idx : finished)
-                    {
-                        PCB& proc = process_pool[idx];
-                        if (proc.getRemainingTime() > 0 && proc.isReady())
-                        {
-                            readyQueue[proc.getPriority()].push(idx);
-                        }
-                    }
-                    if (!finished.empty())
-                    {
-                        IO_Processes->clearFinished();
-                    }
-                }
+            oss << "\n========================\n";
+            oss << "IO wait queue size: " << IO_Processes->size();
 
-                //***** To track first response for processes *****//
-                if (!p.isFirstResponse())  // if its the process' first time about to execute, set
-                                           // these values.
-                {
-                    p.recordFirstResponse(currentTime);
-                }
+            return oss.str();
+        });
 
-                //***** Execute process *****//
-                int timeElapsed = p.execute(time_quantum_sched);
-                currentTime += timeElapsed;
-                debug(EXEC,
-                      std::format("[EXEC] PID: {} ran for {} -> remaining time: {} at time {}",
-                                  p.getPid(),
-                                  timeElapsed,
-                                  p.getRemainingTime(),
-                                  currentTime));
+    size_t i = popReady(el);
 
-                //***** handle state transitions + Update IO Wait Queue *****//
+    PCB& p = process_pool[i];
 
-                if (p.isWaitingIO() && !IO_Processes->containsPID(p.getPid()))
-                {
-                    IO_Processes->enqueue(i);
-                    IO_Processes->updateIO();
-                }
+    //***** check if context switch *****//
+    bool switched = lastProcess.has_value() && p.getPid() != lastProcess->getPid();
+    if (switched)
+    {
+        currentTime += context_switch_time_sched;  // increment with context switch
+    }
 
-                if (p.isReady() && timeElapsed > 0)
-                    readyQueue[el].push(i);
+    //***** calculate time delta *****//
+    dispatch_delta = currentTime - lastTime;
 
-                if (p.getRemainingTime() <= 0)
-                {
-                    debug(EXEC, std::format("Process PID: {}, finished", p.getPid()));
-                    p.setCompletionTime(currentTime);
-                }
+    //***** IO Wait Queue management *****//
+    // want to process IO first, for alredy waiting processes
+    if (dispatch_delta > 0)
+    {
+        IO_Processes->processIO(dispatch_delta);
 
-                //***** Update aging *****//
-                updateQueuesAfterAging(&p, delta);
+        // finished IO processes go back to the ready queue before this process is requeued.
+        const auto& finished = IO_Processes->getFinishedProcesses();
+        for (size_t idx : finished)
+        {
+            calendar.schedule(currentTime, EventType::IO_COMPLETION, idx);
+        }
+        if (!finished.empty())
+        {
+            IO_Processes->clearFinished();
+        }
+    }
 
-                lastTime = currentTime;
-                lastProcess.emplace(p);
-                //***** Update logs *****//
-                logEvent(&p);
-                break;
-            }
+    //***** To track first response for processes *****//
+    if (!p.isFirstResponse())  // if its the process' first time about to execute, set
+                               // these values.
+    {
+        p.recordFirstResponse(currentTime);
+    }
+
+    //***** Execute process *****//
+    dispatch_elapsed = p.execute(time_quantum_sched);
+    calendar.schedule(currentTime + dispatch_elapsed, EventType::QUANTUM_EXPIRY, i);
+    metrics->recordExecution(currentTime, dispatch_elapsed);
+
+    //***** Update timeline *****//
+    if (timeline.isOpen())
+    {
+        if (switched)
+        {
+            timeline.contextSwitch(
+                0, currentTime - context_switch_time_sched, context_switch_time_sched);
+        }
+        if (dispatch_elapsed > 0)
+        {
+            timeline.cpuSlice(0, p.getPid(), p.getPriority(), currentTime, dispatch_elapsed);
         }
     }
+}
 
-    // when finished write all to logs.
-    debug(EXEC, "Flushing logs");
-    flushLogs();
+void Scheduler::onQuantumExpiry(size_t i)
+{
+    PCB& p = process_pool[i];
+    int timeElapsed = dispatch_elapsed;
+
+    debug<EXEC>(
+        [&]()
+        {
+            return std::format("[EXEC] PID: {} ran for {} -> remaining time: {} at time {}",
+                               p.getPid(),
+                               timeElapsed,
+                               p.getRemainingTime(),
+                               currentTime);
+        });
+
+    //***** handle state transitions + Update IO Wait Queue *****//
+
+    if (p.isWaitingIO() && !IO_Processes->contains(i))
+    {
+        IO_Processes->enqueue(i);
+        IO_Processes->updateIO();
+        if (timeline.isOpen())
+            timeline.ioBegin(0, p.getPid(), currentTime);
+    }
+
+    if (p.isReady() && timeElapsed > 0)
+        pushReady(p.getPriority(), i);
+
+    if (p.getRemainingTime() <= 0)
+    {
+        debug<EXEC>(
+            [&]()
+            {
+                return std::format("Process PID: {}, finished", p.getPid());
+            });
+        p.setCompletionTime(currentTime);
+        metrics->recordCompletion(i);
+        if (timeElapsed > 0)
+            unfinished_processes--;  // only count the transition into finished
+    }
+
+    //***** Update aging *****//
+    updateQueuesAfterAging(i, dispatch_delta);
+
+    lastProcess.emplace(p);
+    //***** Update logs *****//
+    logEvent(i);
 }
 
 void Scheduler::run()
@@ -386,33 +594,83 @@ void Scheduler::run()
         switch (curr_state)
         {
             case Process_STATE::READY:
-                debug(EXEC, "In Process_State ready");
+                debug<EXEC>("In Process_State ready");
                 priorityScheduling();
                 curr_state = Process_STATE::RUNNING;
                 break;
 
             case Process_STATE::RUNNING:
-                debug(EXEC, "In Process_State Running");
+                debug<EXEC>("In Process_State Running");
                 roundRobin();
                 curr_state = Process_STATE::FINISHED;
                 break;
 
             case Process_STATE::FINISHED:
-                debug(EXEC, "In Process_State finished");
-                SystemMetrics sm{};
-                sm = metrics->calculate(currentTime);
+                debug<EXEC>("In Process_State finished");
+                metrics->calculate(currentTime);
                 metrics->writeToFile(logs_name + "_metrics");
+                metrics->writeWindowsToFile(logs_name + "_windows", currentTime);
+                if (queueStats)
+                    queueStats->writeToFile(logs_name + "_queues", currentTime);
                 finished_flag = true;
                 break;
         }
     }
 }
 
+SystemMetrics Scheduler::getMetricsSnapshot() const
+{
+    return metrics->snapshot(currentTime);
+}
+
+void Scheduler::enableWindowedMetrics(long long window_ticks, size_t windows)
+{
+    metrics->enableWindows(window_ticks, windows);
+}
+
+void Scheduler::enableQueueStats()
+{
+    queueStats.emplace(max_priority_sched, process_pool.size());
+}
+
+const std::optional<QueueStats>& Scheduler::getQueueStats() const
+{
+    return queueStats;
+}
+
 PCB& Scheduler::getProcessByPID(int pid)
 {
     return process_pool[pid - 1];
 }
 
+void Scheduler::pushReady(int level, size_t idx)
+{
+    readyQueue.push(level, idx);
+    aging->track(idx);
+    if (queueStats)
+        queueStats->onEnqueue(level, idx, currentTime);
+}
+
+size_t Scheduler::popReady(int level)
+{
+    size_t idx = readyQueue.pop(level);
+    aging->untrack(idx);
+    if (queueStats)
+        queueStats->onDequeue(level, idx, currentTime);
+    return idx;
+}
+
+// only used by aging, the process is pushed again at its new level
+void Scheduler::removeReady(int level, size_t idx)
+{
+    if (readyQueue.remove(level, idx))
+    {
+        aging->untrack(idx);
+        if (queueStats)
+            queueStats->onPromotion(level, idx, currentTime);
+    }
+}
+
 size_t Scheduler::pidToIndex(int pid) const
 {
     return pid - 1;
@@ -447,3 +705,17 @@ int Scheduler::getDebugLevel() const
 {
     return debug_level;
 }
+
+void Scheduler::enableDebugSink(DebugSink::Mode mode, size_t capacity, int fd)
+{
+    debugSink.reset();  // outputs whatever the previous sink still holds
+    debugSink.emplace(mode, capacity, fd);
+}
+
+std::optional<DebugSinkStats> Scheduler::getDebugSinkStats() const
+{
+    if (!debugSink)
+        return std::nullopt;
+
+    return debugSink->getStats();
+}
@@ -0,0 +1,371 @@
+#include "SimdKernels.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// ProcessState is loaded as 32-bit lanes next to the int columns.
+static_assert(sizeof(ProcessState) == sizeof(int), "ProcessState must be 32-bit");
+// the IO kernels set READY by clearing the state lanes of the finished rows (andnot).
+static_assert(static_cast<int>(ProcessState::READY) == 0, "ProcessState::READY must be 0");
+
+static constexpr int READY_LANE = static_cast<int>(ProcessState::READY);
+static constexpr int WAITING_IO_LANE = static_cast<int>(ProcessState::WAITING_IO);
+
+//***** scalar *****//
+
+static size_t ageScalar(int* waiting,
+                        int* prio,
+                        const ProcessState* state,
+                        const int* aging_limit,
+                        size_t from,
+                        size_t to,
+                        int delta,
+                        size_t skip,
+                        size_t* out)
+{
+    size_t count = 0;
+    for (size_t idx = from; idx < to; idx++)
+    {
+        if (idx == skip || state[idx] != ProcessState::READY)
+            continue;
+
+        waiting[idx] += delta;
+        if (waiting[idx] >= aging_limit[idx] && prio[idx] > 1)
+        {
+            prio[idx]--;
+            waiting[idx] = 0;
+            out[count++] = idx;
+        }
+    }
+    return count;
+}
+
+static size_t ioScalar(int* io_remaining,
+                       int* total_io,
+                       int* waiting,
+                       ProcessState* state,
+                       size_t from,
+                       size_t to,
+                       int delta,
+                       size_t* out)
+{
+    size_t count = 0;
+    for (size_t idx = from; idx < to; idx++)
+    {
+        if (state[idx] != ProcessState::WAITING_IO)
+            continue;
+
+        int passed = std::min(io_remaining[idx], delta);
+        io_remaining[idx] -= passed;
+        total_io[idx] += passed;
+
+        if (io_remaining[idx] <= 0)
+        {
+            io_remaining[idx] = 0;
+            waiting[idx] = 0;
+            state[idx] = ProcessState::READY;
+            out[count++] = idx;
+        }
+    }
+    return count;
+}
+
+// lane mask bits -> row indices
+static size_t collect(unsigned bits, size_t base, size_t* out)
+{
+    size_t count = 0;
+    while (bits != 0)
+    {
+        out[count++] = base + std::countr_zero(bits);
+        bits &= bits - 1;
+    }
+    return count;
+}
+
+#ifdef KERNELS_X86
+
+//***** SSE2, 4 lanes *****//
+
+__attribute__((target("sse2"))) static inline __m128i select128(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+__attribute__((target("sse2"))) static size_t ageSSE2(int* waiting,
+                                                      int* prio,
+                                                      const ProcessState* state,
+                                                      const int* aging_limit,
+                                                      size_t n,
+                                                      int delta,
+                                                      size_t skip,
+                                                      size_t* out)
+{
+    const __m128i vdelta = _mm_set1_epi32(delta);
+    const __m128i vready = _mm_set1_epi32(READY_LANE);
+    const __m128i vone = _mm_set1_epi32(1);
+
+    size_t count = 0;
+    size_t idx = 0;
+    for (; idx + 4 <= n; idx += 4)
+    {
+        if (skip - idx < 4)  // the skipped row is in this block
+        {
+            count += ageScalar(
+                waiting, prio, state, aging_limit, idx, idx + 4, delta, skip, out + count);
+            continue;
+        }
+
+        __m128i st = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + idx));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(waiting + idx));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prio + idx));
+        __m128i lim = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aging_limit + idx));
+
+        __m128i ready = _mm_cmpeq_epi32(st, vready);
+        __m128i aged = _mm_add_epi32(w, vdelta);
+        __m128i reached = _mm_andnot_si128(_mm_cmpgt_epi32(lim, aged), ready);
+        __m128i promote = _mm_and_si128(reached, _mm_cmpgt_epi32(p, vone));
+
+        __m128i w_new = _mm_andnot_si128(promote, select128(ready, aged, w));
+        __m128i p_new = _mm_add_epi32(p, promote);  // promote lanes are -1
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(waiting + idx), w_new);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(prio + idx), p_new);
+
+        count += collect(_mm_movemask_ps(_mm_castsi128_ps(promote)), idx, out + count);
+    }
+
+    count += ageScalar(waiting, prio, state, aging_limit, idx, n, delta, skip, out + count);
+    return count;
+}
+
+__attribute__((target("sse2"))) static size_t ioSSE2(int* io_remaining,
+                                                     int* total_io,
+                                                     int* waiting,
+                                                     ProcessState* state,
+                                                     size_t n,
+                                                     int delta,
+                                                     size_t* out)
+{
+    const __m128i vdelta = _mm_set1_epi32(delta);
+    const __m128i vwaiting = _mm_set1_epi32(WAITING_IO_LANE);
+    const __m128i vone = _mm_set1_epi32(1);
+
+    size_t count = 0;
+    size_t idx = 0;
+    for (; idx + 4 <= n; idx += 4)
+    {
+        __m128i st = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + idx));
+        __m128i io = _mm_loadu_si128(reinterpret_cast<const __m128i*>(io_remaining + idx));
+        __m128i tot = _mm_loadu_si128(reinterpret_cast<const __m128i*>(total_io + idx));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(waiting + idx));
+
+        __m128i in_io = _mm_cmpeq_epi32(st, vwaiting);
+        __m128i passed = select128(_mm_cmpgt_epi32(io, vdelta), vdelta, io);
+        __m128i io_left = _mm_sub_epi32(io, passed);
+        __m128i finished = _mm_and_si128(in_io, _mm_cmpgt_epi32(vone, io_left));
+
+        __m128i io_new = _mm_andnot_si128(finished, select128(in_io, io_left, io));
+        __m128i tot_new = select128(in_io, _mm_add_epi32(tot, passed), tot);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(io_remaining + idx), io_new);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(total_io + idx), tot_new);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(waiting + idx), _mm_andnot_si128(finished, w));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + idx), _mm_andnot_si128(finished, st));
+
+        count += collect(_mm_movemask_ps(_mm_castsi128_ps(finished)), idx, out + count);
+    }
+
+    count += ioScalar(io_remaining, total_io, waiting, state, idx, n, delta, out + count);
+    return count;
+}
+
+//***** AVX2, 8 lanes *****//
+
+__attribute__((target("avx2"))) static size_t ageAVX2(int* waiting,
+                                                      int* prio,
+                                                      const ProcessState* state,
+                                                      const int* aging_limit,
+                                                      size_t n,
+                                                      int delta,
+                                                      size_t skip,
+                                                      size_t* out)
+{
+    const __m256i vdelta = _mm256_set1_epi32(delta);
+    const __m256i vready = _mm256_set1_epi32(READY_LANE);
+    const __m256i vone = _mm256_set1_epi32(1);
+
+    size_t count = 0;
+    size_t idx = 0;
+    for (; idx + 8 <= n; idx += 8)
+    {
+        if (skip - idx < 8)  // the skipped row is in this block
+        {
+            count += ageScalar(
+                waiting, prio, state, aging_limit, idx, idx + 8, delta, skip, out + count);
+            continue;
+        }
+
+        __m256i st = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + idx));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(waiting + idx));
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prio + idx));
+        __m256i lim = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aging_limit + idx));
+
+        __m256i ready = _mm256_cmpeq_epi32(st, vready);
+        __m256i aged = _mm256_add_epi32(w, vdelta);
+        __m256i reached = _mm256_andnot_si256(_mm256_cmpgt_epi32(lim, aged), ready);
+        __m256i promote = _mm256_and_si256(reached, _mm256_cmpgt_epi32(p, vone));
+
+        __m256i w_new = _mm256_andnot_si256(promote, _mm256_blendv_epi8(w, aged, ready));
+        __m256i p_new = _mm256_add_epi32(p, promote);  // promote lanes are -1
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(waiting + idx), w_new);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(prio + idx), p_new);
+
+        count += collect(_mm256_movemask_ps(_mm256_castsi256_ps(promote)), idx, out + count);
+    }
+
+    count += ageScalar(waiting, prio, state, aging_limit, idx, n, delta, skip, out + count);
+    return count;
+}
+
+__attribute__((target("avx2"))) static size_t ioAVX2(int* io_remaining,
+                                                     int* total_io,
+                                                     int* waiting,
+                                                     ProcessState* state,
+                                                     size_t n,
+                                                     int delta,
+                                                     size_t* out)
+{
+    const __m256i vdelta = _mm256_set1_epi32(delta);
+    const __m256i vwaiting = _mm256_set1_epi32(WAITING_IO_LANE);
+    const __m256i vone = _mm256_set1_epi32(1);
+
+    size_t count = 0;
+    size_t idx = 0;
+    for (; idx + 8 <= n; idx += 8)
+    {
+        __m256i st = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + idx));
+        __m256i io = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(io_remaining + idx));
+        __m256i tot = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(total_io + idx));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(waiting + idx));
+
+        __m256i in_io = _mm256_cmpeq_epi32(st, vwaiting);
+        __m256i passed = _mm256_min_epi32(io, vdelta);
+        __m256i io_left = _mm256_sub_epi32(io, passed);
+        __m256i finished = _mm256_and_si256(in_io, _mm256_cmpgt_epi32(vone, io_left));
+
+        __m256i io_new = _mm256_andnot_si256(finished, _mm256_blendv_epi8(io, io_left, in_io));
+        __m256i tot_new = _mm256_blendv_epi8(tot, _mm256_add_epi32(tot, passed), in_io);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(io_remaining + idx), io_new);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(total_io + idx), tot_new);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(waiting + idx),
+                            _mm256_andnot_si256(finished, w));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + idx),
+                            _mm256_andnot_si256(finished, st));
+
+        count += collect(_mm256_movemask_ps(_mm256_castsi256_ps(finished)), idx, out + count);
+    }
+
+    count += ioScalar(io_remaining, total_io, waiting, state, idx, n, delta, out + count);
+    return count;
+}
+
+#endif
+
+//***** runtime dispatch *****//
+
+KernelIsa detectKernelIsa()
+{
+#ifdef KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return KernelIsa::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return KernelIsa::SSE2;
+#endif
+    return KernelIsa::SCALAR;
+}
+
+static KernelIsa& activeIsa()
+{
+    static KernelIsa isa = detectKernelIsa();
+    return isa;
+}
+
+KernelIsa getKernelIsa()
+{
+    return activeIsa();
+}
+
+bool setKernelIsa(KernelIsa isa)
+{
+    if (static_cast<int>(isa) > static_cast<int>(detectKernelIsa()))
+        return false;
+
+    activeIsa() = isa;
+    return true;
+}
+
+const char* kernelIsaName(KernelIsa isa)
+{
+    switch (isa)
+    {
+        case KernelIsa::AVX2:
+            return "AVX2";
+        case KernelIsa::SSE2:
+            return "SSE2";
+        default:
+            return "SCALAR";
+    }
+}
+
+size_t ageKernel(int* waiting,
+                 int* prio,
+                 const ProcessState* state,
+                 const int* aging_limit,
+                 size_t n,
+                 int delta,
+                 size_t skip,
+                 size_t* out)
+{
+    switch (activeIsa())
+    {
+#ifdef KERNELS_X86
+        case KernelIsa::AVX2:
+            return ageAVX2(waiting, prio, state, aging_limit, n, delta, skip, out);
+        case KernelIsa::SSE2:
+            return ageSSE2(waiting, prio, state, aging_limit, n, delta, skip, out);
+#endif
+        default:
+            return ageScalar(waiting, prio, state, aging_limit, 0, n, delta, skip, out);
+    }
+}
+
+size_t ioCountdownKernel(int* io_remaining,
+                         int* total_io,
+                         int* waiting,
+                         ProcessState* state,
+                         size_t n,
+                         int delta,
+                         size_t* out)
+{
+    int time_diff = std::max(0, delta);  // secure time_diff is positive.
+
+    switch (activeIsa())
+    {
+#ifdef KERNELS_X86
+        case KernelIsa::AVX2:
+            return ioAVX2(io_remaining, total_io, waiting, state, n, time_diff, out);
+        case KernelIsa::SSE2:
+            return ioSSE2(io_remaining, total_io, waiting, state, n, time_diff, out);
+#endif
+        default:
+            return ioScalar(io_remaining, total_io, waiting, state, 0, n, time_diff, out);
+    }
+}
@@ -0,0 +1,119 @@
+#include "WindowedCounters.h"
+
+#include <algorithm>
+
+WindowedCounters::WindowedCounters(long long window_ticks, size_t capacity)
+    : ring(std::max<size_t>(1, capacity)), window_ticks(std::max(1LL, window_ticks))
+{
+}
+
+void WindowedCounters::addBusy(long long start, long long duration)
+{
+    while (duration > 0)
+    {
+        long long window_end = (start / window_ticks + 1) * window_ticks;
+        long long part = std::min(duration, window_end - start);
+
+        MetricsWindow* window = windowAt(start);
+        if (window != nullptr)
+            window->busy += part;
+
+        start += part;
+        duration -= part;
+    }
+}
+
+void WindowedCounters::addDispatch(long long time)
+{
+    MetricsWindow* window = windowAt(time);
+    if (window != nullptr)
+        window->dispatches++;
+}
+
+void WindowedCounters::addCompletion(long long time)
+{
+    MetricsWindow* window = windowAt(time);
+    if (window != nullptr)
+        window->completions++;
+}
+
+void WindowedCounters::clear()
+{
+    std::fill(ring.begin(), ring.end(), MetricsWindow{});
+    newest = -1;
+}
+
+std::vector<MetricsWindow> WindowedCounters::getWindows() const
+{
+    std::vector<MetricsWindow> windows;
+    if (newest < 0)
+        return windows;
+
+    long long capacity = static_cast<long long>(ring.size());
+    long long oldest = std::max(0LL, newest - capacity + 1);
+    windows.reserve(static_cast<size_t>(newest - oldest + 1));
+    for (long long w = oldest; w <= newest; w++)
+    {
+        windows.push_back(ring[static_cast<size_t>(w % capacity)]);
+    }
+    return windows;
+}
+
+json WindowedCounters::toJson(long long end_time) const
+{
+    json windows = json::array();
+    for (const auto& window : getWindows())
+    {
+        // the last window may only be partly over
+        long long length = std::clamp(end_time - window.start, 1LL, window_ticks);
+        windows.push_back({{"start", window.start},
+                           {"busy", window.busy},
+                           {"dispatches", window.dispatches},
+                           {"completions", window.completions},
+                           {"utilization", static_cast<double>(window.busy) / length * 100},
+                           {"throughput", static_cast<double>(window.completions) / length}});
+    }
+
+    return {{"window ticks", window_ticks},
+            {"capacity", ring.size()},
+            {"dropped windows", getDroppedWindows()},
+            {"windows", windows}};
+}
+
+long long WindowedCounters::getWindowTicks() const
+{
+    return window_ticks;
+}
+
+size_t WindowedCounters::getCapacity() const
+{
+    return ring.size();
+}
+
+long long WindowedCounters::getDroppedWindows() const
+{
+    return std::max(0LL, newest + 1 - static_cast<long long>(ring.size()));
+}
+
+// the window holding time, rolling the ring forward if needed. nullptr if already dropped.
+MetricsWindow* WindowedCounters::windowAt(long long time)
+{
+    long long capacity = static_cast<long long>(ring.size());
+    long long w = std::max(0LL, time) / window_ticks;
+
+    if (w > newest)
+    {
+        // reset the slots of the new windows, at most one pass over the ring.
+        for (long long next = std::max(newest + 1, w - capacity + 1); next <= w; next++)
+        {
+            ring[static_cast<size_t>(next % capacity)] = MetricsWindow{next * window_ticks, 0, 0, 0};
+        }
+        newest = w;
+    }
+    else if (w <= newest - capacity)
+    {
+        return nullptr;
+    }
+
+    return &ring[static_cast<size_t>(w % capacity)];
+}
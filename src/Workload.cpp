@@ -0,0 +1,182 @@
+#include "Workload.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+static constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+//***** checksum *****//
+
+void WorkloadChecksum::add(const void* data, size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    for (size_t pos = 0; pos + sizeof(uint32_t) <= size; pos += sizeof(uint32_t))
+    {
+        uint32_t word;
+        std::memcpy(&word, bytes + pos, sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+}
+
+uint64_t WorkloadChecksum::value() const
+{
+    return hash;
+}
+
+// the body hash continued over the header, taken with checksum = 0
+static uint64_t fileChecksum(WorkloadHeader header, WorkloadChecksum body)
+{
+    header.checksum = 0;
+    body.add(&header, sizeof(header));
+    return body.value();
+}
+
+//***** WorkloadWriter *****//
+
+bool WorkloadWriter::open(const fs::path& path, const WorkloadHeader& header)
+{
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open: " << path << " for writing\n";
+        return false;
+    }
+
+    this->header = header;
+    std::memcpy(this->header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+    this->header.version = WORKLOAD_VERSION;
+    this->header.record_size = sizeof(WorkloadRecord);
+    this->header.record_count = 0;
+    this->header.pid_count = 0;
+    this->header.checksum = 0;
+    checksum = WorkloadChecksum{};
+
+    // placeholder, rewritten by close()
+    out.write(reinterpret_cast<const char*>(&this->header), sizeof(this->header));
+    return true;
+}
+
+void WorkloadWriter::writeRecord(const WorkloadRecord& record)
+{
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    checksum.add(&record, sizeof(record));
+    header.record_count++;
+}
+
+void WorkloadWriter::writePid(int32_t pid)
+{
+    out.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+    checksum.add(&pid, sizeof(pid));
+    header.pid_count++;
+}
+
+bool WorkloadWriter::close()
+{
+    if (!out.is_open())
+        return false;
+
+    header.checksum = fileChecksum(header, checksum);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    return !out.fail();
+}
+
+//***** MappedWorkload *****//
+
+MappedWorkload::MappedWorkload(const fs::path& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open workload: " + path.string());
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(WorkloadHeader))
+    {
+        ::close(fd);
+        throw std::runtime_error("Not a scheduler workload: " + path.string());
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file
+    if (map == MAP_FAILED)
+    {
+        length = 0;
+        throw std::runtime_error("Could not map workload: " + path.string());
+    }
+    data = static_cast<const char*>(map);
+    madvise(map, length, MADV_SEQUENTIAL);
+
+    const WorkloadHeader& header = getHeader();
+    std::string error;
+    if (std::memcmp(header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) != 0)
+        error = "Not a scheduler workload: ";
+    else if (header.version == 0 || header.version > WORKLOAD_VERSION)
+        error = "Unsupported workload version " + std::to_string(header.version) + " in ";
+    else if (header.record_size != sizeof(WorkloadRecord) ||
+             header.record_count > length / sizeof(WorkloadRecord) ||
+             length != sizeof(WorkloadHeader) + header.record_count * sizeof(WorkloadRecord) +
+                           header.pid_count * sizeof(int32_t))
+        error = "Invalid workload size in ";
+    else
+    {
+        WorkloadChecksum body;
+        body.add(data + sizeof(WorkloadHeader), length - sizeof(WorkloadHeader));
+        if (fileChecksum(header, body) != header.checksum)
+            error = "Workload checksum mismatch in ";
+    }
+
+    if (!error.empty())
+    {
+        unmap();
+        throw std::runtime_error(error + path.string());
+    }
+}
+
+MappedWorkload::~MappedWorkload()
+{
+    unmap();
+}
+
+const WorkloadHeader& MappedWorkload::getHeader() const
+{
+    return *reinterpret_cast<const WorkloadHeader*>(data);
+}
+
+const WorkloadRecord* MappedWorkload::getRecords() const
+{
+    return reinterpret_cast<const WorkloadRecord*>(data + sizeof(WorkloadHeader));
+}
+
+size_t MappedWorkload::size() const
+{
+    return static_cast<size_t>(getHeader().record_count);
+}
+
+const int32_t* MappedWorkload::getPids() const
+{
+    return reinterpret_cast<const int32_t*>(data + sizeof(WorkloadHeader) +
+                                            size() * sizeof(WorkloadRecord));
+}
+
+void MappedWorkload::unmap()
+{
+    if (data != nullptr)
+    {
+        munmap(const_cast<char*>(data), length);
+        data = nullptr;
+        length = 0;
+    }
+}
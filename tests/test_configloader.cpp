@@ -1,3 +1,5 @@
+#include <fstream>
+
 #include <LogsJson.h>
 
 #include "ConfigLoader.h"
@@ -168,6 +170,296 @@ class ConfigLoaderGetSchedulerConfig : public TestFixture
     }
 };
 
+class ConfigLoaderPriorityLevelsTest : public TestFixture
+{
+   public:
+    ConfigLoaderPriorityLevelsTest() : TestFixture("Priority Levels test")
+    {
+    }
+
+    void writeConfig(const std::string& logfile, int max_priority)
+    {
+        createJSON(logfile);
+
+        // clang-format off
+        json summary;
+        summary["scheduler_config"] = {{"aging_threshold", 5},
+                                        {"max_priority", max_priority},
+                                        {"time_quantum", 4}};
+
+        testProcessConfig testconf_proc;
+        summary["processes"] = json::array({{{"pid", testconf_proc.pid},
+                                     {"priority", max_priority},
+                                     {"burst_time", testconf_proc.burst},
+                                     {"io_bound", testconf_proc.io_bound},
+                                     {"io_interval", testconf_proc.io_interval}}});
+        // clang-format on
+
+        appendToJSON_object(logfile, summary);
+    }
+
+    void test()
+    {
+        std::string logfile = "process_config";
+        trackFile(extensionJSON(logfile));
+
+        // nice-value style range and finer
+        writeConfig(logfile, 140);
+        assert_equal(ConfigLoader(logfile).getSchedulerConfig().max_priority,
+                     140,
+                     "140 priority levels should be accepted");
+
+        writeConfig(logfile, 1024);
+        assert_equal(ConfigLoader(logfile).getSchedulerConfig().max_priority,
+                     1024,
+                     "1024 priority levels should be accepted");
+
+        writeConfig(logfile, MAX_PRIORITY_LEVELS + 1);
+        bool rejected = false;
+        try
+        {
+            ConfigLoader cf(logfile);
+        }
+        catch (std::runtime_error&)
+        {
+            rejected = true;
+        }
+        assert_true(rejected, "max_priority above MAX_PRIORITY_LEVELS should be rejected");
+    }
+};
+
+class ConfigLoaderLogPolicyTest : public TestFixture
+{
+   public:
+    ConfigLoaderLogPolicyTest() : TestFixture("Log Policy test")
+    {
+    }
+
+    void writeConfig(const std::string& logfile, const json& policy)
+    {
+        createJSON(logfile);
+
+        // clang-format off
+        json summary;
+        summary["scheduler_config"] = {{"aging_threshold", 5},
+                                        {"max_priority", 3},
+                                        {"time_quantum", 4},
+                                        {"log_policy", policy}};
+
+        testProcessConfig testconf_proc;
+        summary["processes"] = json::array({{{"pid", testconf_proc.pid},
+                                     {"priority", testconf_proc.priority},
+                                     {"burst_time", testconf_proc.burst},
+                                     {"io_bound", testconf_proc.io_bound},
+                                     {"io_interval", testconf_proc.io_interval}}});
+        // clang-format on
+
+        appendToJSON_object(logfile, summary);
+    }
+
+    void test()
+    {
+        std::string logfile = "process_config";
+        trackFile(extensionJSON(logfile));
+
+        writeConfig(logfile, json::object());
+        LogPolicy defaults = ConfigLoader(logfile).getSchedulerConfig().log_policy;
+        assert_equal(defaults.event_mask, LOG_EVENT_ALL, "Default policy should log every event");
+        assert_equal(defaults.sample_every, 1, "Default policy should not sample");
+
+        writeConfig(logfile,
+                    {{"events", {"FINISHED", "IO_WAIT"}},
+                     {"pids", {1, 3}},
+                     {"sample_every", 10},
+                     {"transitions_only", true}});
+        LogPolicy policy = ConfigLoader(logfile).getSchedulerConfig().log_policy;
+        assert_equal(policy.event_mask,
+                     LOG_EVENT_FINISHED | LOG_EVENT_IO_WAIT,
+                     "Event mask should hold FINISHED and IO_WAIT");
+        assert_equal(policy.pids.size(), 2, "Two pids should be allowlisted");
+        assert_equal(policy.sample_every, 10, "Sampling should be 1 in 10");
+        assert_true(policy.transitions_only, "Transitions only should be set");
+
+        writeConfig(logfile, {{"events", {"SLEEPING"}}});
+        bool rejected = false;
+        try
+        {
+            ConfigLoader cf(logfile);
+        }
+        catch (std::runtime_error&)
+        {
+            rejected = true;
+        }
+        assert_true(rejected, "Unknown event names should be rejected");
+    }
+};
+
+class ConfigLoaderStreamingTest : public TestFixture
+{
+   public:
+    ConfigLoaderStreamingTest() : TestFixture("Streaming Loader test")
+    {
+    }
+
+    void writeText(const std::string& logfile, const std::string& text)
+    {
+        std::ofstream out(makeLogPath(logfile));
+        out << text;
+    }
+
+    bool rejects(const std::string& logfile)
+    {
+        try
+        {
+            ConfigLoader cf(logfile);
+        }
+        catch (std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void test()
+    {
+        std::string logfile = "process_config";
+        trackFile(extensionJSON(logfile));
+
+        // processes first, unknown keys and nested values are skipped
+        writeText(logfile,
+                  R"({"comment": {"processes": [1, 2]},
+                      "processes": [
+                          {"pid": 2, "priority": 1, "burst_time": 7, "io_bound": false,
+                           "io_interval": 0, "tags": ["a", {"b": 1}]},
+                          {"pid": 1, "priority": 3, "burst_time": 9, "io_bound": true,
+                           "io_interval": 4}],
+                      "scheduler_config": {"time_quantum": 6, "extra": [1],
+                                           "max_priority": 5}})");
+        ConfigLoader cf(logfile);
+        const std::vector<ProcessConfig>& processes = cf.getProcessConfig();
+        assert_equal(processes.size(), 2, "Both processes should be loaded");
+        assert_equal(processes[0].pid, 2, "Processes should keep the file order");
+        assert_equal(processes[1].burst, 9, "Burst should be read");
+        assert_true(processes[1].io_bound, "io_bound should be read");
+        assert_equal(cf.getSchedulerConfig().time_quantum, 6, "Quantum read after processes");
+        assert_equal(cf.getSchedulerConfig().aging_threshold,
+                     DEFAULT_AGING_THRESHOLD,
+                     "Missing values should default");
+
+        writeText(logfile,
+                  R"({"scheduler_config": {},
+                      "processes": [{"pid": 1, "priority": 1, "burst_time": 1,
+                                     "io_bound": false}]})");
+        assert_true(rejects(logfile), "A process missing a field should be rejected");
+
+        writeText(logfile,
+                  R"({"scheduler_config": {},
+                      "processes": [
+                          {"pid": 3, "priority": 1, "burst_time": 1, "io_bound": false,
+                           "io_interval": 0},
+                          {"pid": 1, "priority": 1, "burst_time": 1, "io_bound": false,
+                           "io_interval": 0},
+                          {"pid": 3, "priority": 1, "burst_time": 1, "io_bound": false,
+                           "io_interval": 0}]})");
+        assert_true(rejects(logfile), "Duplicate pids out of order should be rejected");
+
+        writeText(logfile, R"({"scheduler_config": {"time_quantum": "4"}, "processes": [])");
+        assert_true(rejects(logfile), "A string quantum should be rejected");
+
+        writeText(logfile,
+                  R"({"scheduler_config": {"time_quantum": 4.0},
+                      "processes": [{"pid": 1, "priority": 1, "burst_time": 2.7,
+                                     "io_bound": false, "io_interval": 0}]})");
+        assert_true(rejects(logfile), "A fractional burst should be rejected");
+
+        writeText(logfile,
+                  R"({"scheduler_config": {"time_quantum": 4.0},
+                      "processes": [{"pid": 1, "priority": 1, "burst_time": 2,
+                                     "io_bound": false, "io_interval": 0}]})");
+        assert_true(!rejects(logfile), "A whole float quantum should be accepted");
+
+        writeText(logfile, R"({"scheduler_config": {}, "processes": [)");
+        assert_true(rejects(logfile), "Truncated json should be rejected");
+
+        writeText(logfile, R"({"processes": []})");
+        assert_true(rejects(logfile), "Missing scheduler_config should be rejected");
+    }
+};
+
+class ConfigLoaderWorkloadTest : public TestFixture
+{
+   public:
+    ConfigLoaderWorkloadTest() : TestFixture("Compiled Workload test")
+    {
+    }
+
+    bool rejects(const std::string& workload)
+    {
+        try
+        {
+            ConfigLoader cf(workload);
+        }
+        catch (std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void test()
+    {
+        std::string logfile = "workload_config";
+        std::string workload = logfile + ".workload";
+        trackFile(extensionJSON(logfile));
+        trackFile(workload);
+
+        std::ofstream(makeLogPath(logfile))
+            << R"({"scheduler_config": {"time_quantum": 6, "max_priority": 7,
+                                         "log_policy": {"pids": [3, 1], "sample_every": 2}},
+                   "processes": [
+                       {"pid": 3, "priority": 7, "burst_time": 12, "io_bound": true,
+                        "io_interval": 5},
+                       {"pid": 1, "priority": 2, "burst_time": 4, "io_bound": false,
+                        "io_interval": 0}]})";
+
+        ConfigLoader json_loader(logfile);
+        std::filesystem::path path = makeLogPath(logfile).replace_extension(".workload");
+        assert_true(json_loader.compileWorkload(path), "Workload should be written");
+        assert_equal(std::filesystem::file_size(path),
+                     sizeof(WorkloadHeader) + 2 * sizeof(WorkloadRecord) + 2 * sizeof(int32_t),
+                     "Workload should hold the header, the records and the pids");
+
+        ConfigLoader cf(workload);
+        assert_true(cf.isCompiledWorkload(), "A .workload file should be mapped");
+        assert_equal(cf.getProcessCount(), 2, "Both processes should be mapped");
+        assert_equal(cf.getSchedulerConfig().time_quantum, 6, "Quantum should be compiled");
+        assert_equal(cf.getSchedulerConfig().max_priority, 7, "Max priority should be compiled");
+        assert_equal(cf.getSchedulerConfig().log_policy.sample_every,
+                     2,
+                     "Log policy should be compiled");
+        assert_equal(cf.getSchedulerConfig().log_policy.pids.size(), 2, "Pids should be compiled");
+
+        const std::vector<ProcessConfig>& processes = cf.getProcessConfig();
+        assert_equal(processes.size(), 2, "Process list should be built from the mapping");
+        assert_equal(processes[0].pid, 3, "Records should keep the file order");
+        assert_equal(processes[0].burst, 12, "Burst should be compiled");
+        assert_true(processes[0].io_bound && !processes[1].io_bound, "io_bound should be compiled");
+        assert_equal(processes[1].io_interval, 0, "io_interval should be compiled");
+
+        // a flipped byte in a record fails the checksum
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(sizeof(WorkloadHeader) + 4);
+            file.put(static_cast<char>(99));
+        }
+        assert_true(rejects(workload), "A corrupted workload should be rejected");
+
+        json_loader.compileWorkload(path);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+        assert_true(rejects(workload), "A truncated workload should be rejected");
+    }
+};
+
 void run_configloader_tests()
 {
     std::cout << "\n==== Configloader Test ====\n";
@@ -209,6 +501,56 @@ void run_configloader_tests()
         failed++;
     }
 
+    try
+    {
+        ConfigLoaderPriorityLevelsTest test4;
+        test4.run([&]() { test4.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [PRIORITY LEVELS TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ConfigLoaderLogPolicyTest test5;
+        test5.run([&]() { test5.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [LOG POLICY TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ConfigLoaderStreamingTest test6;
+        test6.run([&]() { test6.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [STREAMING LOADER TEST] with: " << e.what()
+                  << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ConfigLoaderWorkloadTest test7;
+        test7.run([&]() { test7.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [COMPILED WORKLOAD TEST] with: " << e.what()
+                  << std::endl;
+        failed++;
+    }
+
     std::cout << "Configloader test passed with: " << passed << " passed , " << failed << " failed"
               << std::endl;
 }
\ No newline at end of file
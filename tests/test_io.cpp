@@ -46,6 +46,11 @@ class IOEnqueueTest : public TestFixture
         iom.enqueue(1);
         assert_true(iom.containsPID(2), "IO Queue should now contain process with PID = 2");
         assert_equal(iom.size(), 2, " IO Queue size should now be 2");
+
+        assert_true(iom.contains(1), " IO Queue should contain index 1");
+        assert_true(!iom.contains(2), " IO Queue should not contain index 2");
+        assert_true(!iom.containsPID(3), " IO Queue should not contain process with PID = 3");
+        assert_true(!iom.contains(100), " Unknown index should not be contained");
     }
 };
 
@@ -92,7 +97,7 @@ class IOUpdateTest : public TestFixture
 
         iom.updateIO();
 
-        const std::deque<size_t>& test_deque = iom.getQueue();
+        const std::vector<size_t> test_deque = iom.getQueue();
         assert_equal(test_deque.size(),
                      iom.size(),
                      " test deque must be equal to original deque size (3)");
@@ -175,6 +180,51 @@ class IOProcessTest : public TestFixture
     }
 };
 
+class IOCancelTest : public TestFixture
+{
+   public:
+    IOCancelTest() : TestFixture("IO Manager Cancel Test")
+    {
+    }
+
+    void test()
+    {
+        // clang-format off
+    std::vector<PCB> process = {
+        PCB(1, 1, 10, 1, 6, TEST_AGING, TEST_TIME),
+        PCB(2, 1, 10, 1, 3, TEST_AGING, TEST_TIME),
+        PCB(3, 1, 10, 1, 3, TEST_AGING, TEST_TIME),
+    };
+        // clang-format on
+
+        IOManager iom(process);
+
+        for (size_t idx = 0; idx < process.size(); idx++)
+        {
+            process[idx].setState(ProcessState::WAITING_IO);
+            iom.enqueue(idx);
+        }
+        iom.updateIO();
+
+        iom.processIO(2);
+        assert_equal(iom.getRemainingIOTime(0), 4, " p1 should have 4 (6-2) IO Time left");
+        assert_true(iom.cancel(0), " p1 should be cancelled");
+        assert_true(!iom.cancel(0), " p1 should not be cancelled twice");
+        assert_true(!iom.containsPID(1), " IO Queue should no longer contain p1");
+        assert_equal(process[0].getIORemainingTime(), 4, " Cancel should keep p1's IO Time left");
+        assert_equal(process[0].getTotalIOTime(), 2, " Cancel should keep p1's passed IO Time");
+
+        // same completion time, finishers come out in the order they entered IO
+        iom.processIO(1);
+        std::vector<size_t> expected = {1, 2};
+        assert_true(iom.getFinishedProcesses() == expected,
+                    " p2 and p3 should finish in enqueue order");
+        assert_equal(process[1].getTotalIOTime(), 3, " p2 should have spent 3 in IO");
+        assert_true(iom.isEmpty(), " IO Queue should be empty");
+        assert_equal(iom.getIOClock(), 3, " IO clock should have advanced 3");
+    }
+};
+
 void run_io_tests()
 {
     std::cout << "\n==== IO Manager Test ====\n";
@@ -218,6 +268,19 @@ void run_io_tests()
         failed++;
     }
 
+    try
+    {
+        IOCancelTest test4;
+        test4.run([&]() { test4.test(); });
+        passed++;
+    }
+
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [IO CANCEL TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
     std::cout << "IO test passed with: " << passed << " passed , " << failed << " failed"
               << std::endl;
 }
\ No newline at end of file
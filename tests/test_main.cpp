@@ -1,19 +1,26 @@
 #include <iostream>
+#include <string>
 
 void run_scheduler_tests();
 void run_PCB_tests();
 void run_io_tests();
 void run_configloader_tests();
+void run_queue_tests();
+void run_scale_tests(bool full_scale);
+void run_metrics_tests();
 
-int main()
+// test_scheduler [--scale], --scale adds the 1M process scheduler run
+int main(int argc, char** argv)
 {
+    bool full_scale = argc > 1 && std::string(argv[1]) == "--scale";
+
     std::cout << "=====================\n";
     std::cout << "= TEST SUITE RUNNER =\n";
     std::cout << "=====================\n";
 
     try
     {
-        std::cout << "\n[1/4] Running Scheduler Test..." << std::endl;
+        std::cout << "\n[1/7] Running Scheduler Test..." << std::endl;
         run_scheduler_tests();
         std::cout << "All test suites for scheduler completed succesfully" << std::endl;
     }
@@ -24,7 +31,7 @@ int main()
 
     try
     {
-        std::cout << "\n[2/4] Running PCB Test..." << std::endl;
+        std::cout << "\n[2/7] Running PCB Test..." << std::endl;
         run_PCB_tests();
         std::cout << "All test suites for PCB completed succesfully" << std::endl;
     }
@@ -35,7 +42,7 @@ int main()
 
     try
     {
-        std::cout << "\n[3/4] Running IO Manager Test..." << std::endl;
+        std::cout << "\n[3/7] Running IO Manager Test..." << std::endl;
         run_io_tests();
         std::cout << "All test suites for IO Manager completed succesfully" << std::endl;
     }
@@ -46,9 +53,42 @@ int main()
 
     try
     {
-        std::cout << "\n[4/4] Running Config loader Test..." << std::endl;
+        std::cout << "\n[4/7] Running Config loader Test..." << std::endl;
         run_configloader_tests();
         std::cout << "All test suites for Config loader completed succesfully" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Test Suite failed: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "\n[5/7] Running Queue Test..." << std::endl;
+        run_queue_tests();
+        std::cout << "All test suites for Queue completed succesfully" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Test Suite failed: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "\n[6/7] Running Scale Test..." << std::endl;
+        run_scale_tests(full_scale);
+        std::cout << "All test suites for Scale completed succesfully" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Test Suite failed: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "\n[7/7] Running Metrics Test..." << std::endl;
+        run_metrics_tests();
+        std::cout << "All test suites for Metrics completed succesfully" << std::endl;
         return 0;
     }
     catch (std::exception& e)
@@ -0,0 +1,357 @@
+#include <LogsJson.h>
+
+#include "LatencyHistogram.h"
+#include "Metrics.h"
+#include "QueueStats.h"
+#include "SchedulerClass.h"
+#include "TestFixture.h"
+#include "WindowedCounters.h"
+
+class HistogramPercentileTest : public TestFixture
+{
+   public:
+    HistogramPercentileTest() : TestFixture("Histogram Percentile Test")
+    {
+    }
+
+    void test()
+    {
+        LatencyHistogram h;
+        assert_equal(h.percentile(50.0), 0, " Empty histogram should report 0");
+
+        // 1..1000 once each
+        for (long long v = 1; v <= 1000; v++)
+            h.record(v);
+
+        assert_equal(h.getCount(), 1000, " Histogram should count 1000 values");
+        assert_equal(h.getMin(), 1, " Min should be exact");
+        assert_equal(h.getMax(), 1000, " Max should be exact");
+        assert_true(h.getMean() == 500.5, " Mean should be exact");
+
+        // within one bucket (1/64) of the exact percentile
+        const double ps[] = {50.0, 90.0, 99.0, 99.9};
+        const long long exact[] = {500, 900, 990, 999};
+        for (int n = 0; n < 4; n++)
+        {
+            long long got = h.percentile(ps[n]);
+            assert_true(got >= exact[n] && got <= exact[n] + exact[n] / 64 + 1,
+                        " Percentile should be within the bucket precision");
+        }
+        assert_equal(h.percentile(100.0), 1000, " p100 should be the max");
+
+        // values below 2^SUB_BUCKET_BITS are exact
+        LatencyHistogram small;
+        for (long long v = 0; v < 100; v++)
+            small.record(v);
+        assert_equal(small.percentile(50.0), 49, " Small values should be exact");
+
+        // the bucket count follows the log of the largest value
+        LatencyHistogram wide;
+        wide.record(1'000'000'000LL);
+        assert_true(wide.getBucketCount() < 2000, " Buckets should grow logarithmically");
+        assert_equal(wide.percentile(50.0), 1'000'000'000LL, " Single value clamps to max");
+
+        // every value lands in a bucket that contains it
+        for (long long v : {0LL, 1LL, 127LL, 128LL, 129LL, 255LL, 256LL, 4097LL, 123456789LL})
+        {
+            size_t idx = LatencyHistogram::bucketIndex(v);
+            assert_true(LatencyHistogram::bucketLowest(idx) <= v &&
+                            v <= LatencyHistogram::bucketHighest(idx),
+                        " Value should be inside its bucket");
+        }
+    }
+};
+
+class HistogramMergeTest : public TestFixture
+{
+   public:
+    HistogramMergeTest() : TestFixture("Histogram Merge Test")
+    {
+    }
+
+    void test()
+    {
+        LatencyHistogram low, high, all;
+        for (long long v = 0; v < 5000; v++)
+        {
+            (v % 2 == 0 ? low : high).record(v * 3);
+            all.record(v * 3);
+        }
+
+        LatencyHistogram merged = low;
+        merged.merge(high);
+        assert_equal(merged.getCount(), all.getCount(), " Merged count should match");
+        assert_equal(merged.getMin(), all.getMin(), " Merged min should match");
+        assert_equal(merged.getMax(), all.getMax(), " Merged max should match");
+        assert_equal(merged.percentile(99.0), all.percentile(99.0), " Merged p99 should match");
+        assert_equal(merged.percentile(99.9), all.percentile(99.9), " Merged p99.9 should match");
+
+        // only the non-empty buckets are written, and they read back to the same histogram
+        LatencyHistogram sparse;
+        sparse.record(5);
+        sparse.record(1'000'000);
+        assert_equal(sparse.toJson()["buckets"].size(), 2, " Only non-empty buckets are written");
+
+        json j = all.toJson();
+        LatencyHistogram back = LatencyHistogram::fromJson(j);
+        assert_equal(back.getCount(), all.getCount(), " Read back count should match");
+        assert_equal(back.percentile(90.0), all.percentile(90.0), " Read back p90 should match");
+        assert_equal(back.getMax(), all.getMax(), " Read back max should match");
+
+        // remove takes a value back out
+        all.remove(0);
+        assert_equal(all.getCount(), 4999, " Removed value should not be counted");
+    }
+};
+
+class MetricsHistogramTest : public TestFixture
+{
+   public:
+    MetricsHistogramTest() : TestFixture("Metrics Histogram Test")
+    {
+    }
+
+    void test()
+    {
+        // two priority levels, processes complete back to back
+        std::vector<PCB> pool;
+        for (int pid = 1; pid <= 20; pid++)
+            pool.emplace_back(pid, pid <= 10 ? 1 : 2, pid, false, 0, 5, 4);
+
+        Metrics metrics(pool);
+        int time = 0;
+        for (size_t idx = 0; idx < pool.size(); idx++)
+        {
+            pool[idx].recordFirstResponse(time);
+            while (pool[idx].getRemainingTime() > 0)
+                time += pool[idx].execute(4);
+            pool[idx].setCompletionTime(time);
+            metrics.recordCompletion(idx);
+        }
+
+        const SystemMetrics& result = metrics.calculate(time);
+        assert_equal(result.turnaround_percentiles.p999, time, " Tail should be the last one");
+        assert_true(result.turnaround_percentiles.p50 < result.turnaround_percentiles.p90,
+                    " p50 should be below p90");
+
+        const auto& levels = metrics.getPriorityHistograms();
+        assert_equal(levels.size(), 2, " Two initial priorities should be tracked");
+        assert_equal(levels.at(1).turnaround.getCount(), 10, " 10 processes at priority 1");
+        assert_true(levels.at(1).turnaround.getMax() < levels.at(2).turnaround.getMin(),
+                    " Priority 1 completed first");
+
+        // the levels merge back into the overall histogram
+        LatencyHistograms merged;
+        for (const auto& [prio, level] : levels)
+            merged.merge(level);
+        assert_equal(merged.response.getCount(), metrics.getHistograms().response.getCount(),
+                     " Levels should add up to the overall histogram");
+
+        json j = metrics.toJson();
+        assert_true(j["latency_histograms"]["per_priority"].contains("2"),
+                    " Per priority histograms should be written");
+        assert_equal(j["latency_histograms"]["overall"]["turnaround time"]["count"].get<int>(),
+                     20,
+                     " Overall histogram should be written");
+    }
+};
+
+class WindowedCountersTest : public TestFixture
+{
+   public:
+    WindowedCountersTest() : TestFixture("Windowed Counters Test")
+    {
+    }
+
+    void test()
+    {
+        WindowedCounters counters(100, 4);
+        assert_true(counters.getWindows().empty(), " Counters should start empty");
+
+        // 150 busy ticks from 50, split over the first two windows
+        counters.addDispatch(50);
+        counters.addBusy(50, 150);
+        counters.addCompletion(199);
+        std::vector<MetricsWindow> windows = counters.getWindows();
+        assert_equal(windows.size(), 2, " Busy period should cover two windows");
+        assert_equal(windows[0].busy, 50, " First window busy 50..99");
+        assert_equal(windows[1].busy, 100, " Second window busy 100..199");
+        assert_equal(windows[0].dispatches, 1, " Dispatch counted where it started");
+        assert_equal(windows[1].completions, 1, " Completion counted at its time");
+
+        json j = counters.toJson(200);
+        assert_true(j["windows"][1]["utilization"].get<double>() == 100.0,
+                    " Second window fully utilized");
+        assert_true(j["windows"][0]["utilization"].get<double>() == 50.0,
+                    " First window half utilized");
+
+        // the ring holds 4 windows, older ones are dropped
+        counters.addCompletion(650);
+        windows = counters.getWindows();
+        assert_equal(windows.size(), 4, " Ring should hold at most 4 windows");
+        assert_equal(windows.front().start, 300, " Oldest kept window should start at 300");
+        assert_equal(windows.back().completions, 1, " Newest window should count the completion");
+        assert_equal(counters.getDroppedWindows(), 3, " Three windows should be dropped");
+
+        counters.addCompletion(10);  // already dropped
+        assert_equal(counters.getWindows().front().completions, 0, " Late update is ignored");
+
+        // a gap longer than the ring resets every slot
+        counters.addBusy(10'000, 10);
+        windows = counters.getWindows();
+        assert_equal(windows.back().start, 10'000, " Newest window should follow the time");
+        assert_equal(windows.front().busy + windows.front().completions, 0, " Gap windows empty");
+
+        // scheduler export next to the metrics file
+        std::string logfile = "windowed_metrics_test";
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+        trackFile(extensionJSON(logfile + "_windows"));
+        auto config = std::filesystem::current_path() / "config" / "process_config.json";
+        Scheduler scheduler(logfile, config.string());
+        scheduler.enableWindowedMetrics(10, 64);
+        scheduler.run();
+
+        json series = json::parse(std::ifstream(makeLogPath(logfile + "_windows")))[0];
+        long long busy = 0;
+        int completions = 0;
+        for (const auto& window : series["windows"])
+        {
+            busy += window["busy"].get<long long>();
+            completions += window["completions"].get<int>();
+        }
+        assert_equal(busy, 10 + 8 + 22, " Windows should hold every executed tick");
+        assert_equal(completions, 3, " Windows should hold every completion");
+    }
+};
+
+class QueueStatsTest : public TestFixture
+{
+   public:
+    QueueStatsTest() : TestFixture("Queue Stats Test")
+    {
+    }
+
+    void test()
+    {
+        QueueStats stats(3, 4);
+
+        // level 2: depth 1 over [0, 10), 2 over [10, 20), 1 over [20, 40)
+        stats.onEnqueue(2, 0, 0);
+        stats.onEnqueue(2, 1, 10);
+        stats.onDequeue(2, 0, 20);
+        stats.onPromotion(2, 1, 40);
+        stats.onEnqueue(1, 1, 40);
+
+        const LevelQueueStats& level = stats.getLevel(2);
+        assert_equal(level.enqueues, 2, " Level 2 should count two enqueues");
+        assert_equal(level.dequeues, 1, " Level 2 should count one dequeue");
+        assert_equal(level.promotions, 1, " Level 2 should count one promotion");
+        assert_equal(level.max_depth, 2, " Level 2 max depth should be 2");
+        assert_equal(level.depth, 0, " Level 2 should be empty");
+        assert_true(stats.getAverageDepth(2, 40) == 1.25, " Average depth (10 + 20 + 20) / 40");
+        assert_true(stats.getAverageDepth(2, 80) == 0.625, " Empty time lowers the average");
+        assert_equal(level.wait.getMin(), 20, " Dispatched after waiting 20");
+        assert_equal(level.wait.getMax(), 30, " Promoted after waiting 30");
+        assert_equal(stats.getLevel(1).depth, 1, " Promoted process queued at level 1");
+
+        json j = stats.toJson(80);
+        assert_equal(j.size(), 2, " Only used levels are exported");
+        assert_equal(j[0]["level"].get<int>(), 1, " Levels exported in order");
+
+        // scheduler export next to the metrics file
+        std::string logfile = "queue_stats_test";
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+        trackFile(extensionJSON(logfile + "_queues"));
+        auto config = std::filesystem::current_path() / "config" / "process_config.json";
+        Scheduler scheduler(logfile, config.string());
+        scheduler.enableQueueStats();
+        scheduler.run();
+
+        const QueueStats& run_stats = *scheduler.getQueueStats();
+        uint64_t enqueues = 0, left = 0;
+        for (int l = 1; l <= run_stats.getMaxPriority(); l++)
+        {
+            const LevelQueueStats& s = run_stats.getLevel(l);
+            enqueues += s.enqueues;
+            left += s.dequeues + s.promotions;
+            assert_equal(s.depth, 0, " Every level should be empty at the end");
+        }
+        assert_true(enqueues >= 3, " Every process should be enqueued");
+        assert_equal(enqueues, left, " Every enqueue should leave the queue");
+
+        json levels = json::parse(std::ifstream(makeLogPath(logfile + "_queues")))[0];
+        assert_true(!levels.empty(), " Queue stats file should list the used levels");
+    }
+};
+
+void run_metrics_tests()
+{
+    std::cout << "\n==== Metrics Test ====\n";
+    int passed = 0, failed = 0;
+
+    try
+    {
+        HistogramPercentileTest test1;
+        test1.run([&]() { test1.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [HISTOGRAM PERCENTILE TEST] with: " << e.what()
+                  << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        HistogramMergeTest test2;
+        test2.run([&]() { test2.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [HISTOGRAM MERGE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        MetricsHistogramTest test3;
+        test3.run([&]() { test3.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [METRICS HISTOGRAM TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        WindowedCountersTest test4;
+        test4.run([&]() { test4.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [WINDOWED COUNTERS TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        QueueStatsTest test5;
+        test5.run([&]() { test5.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [QUEUE STATS TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    std::cout << "Metrics test passed with: " << passed << " passed , " << failed << " failed"
+              << std::endl;
+}
@@ -1,4 +1,9 @@
+#include <vector>
+
+#include "AgingEngine.h"
 #include "PCB.h"
+#include "ProcessTable.h"
+#include "SimdKernels.h"
 #include "TestFixture.h"
 
 const int TEST_AGING = 5;
@@ -89,6 +94,190 @@ class PCBAgeTest : public TestFixture
     }
 };
 
+class PCBLazyAgingTest : public TestFixture
+{
+   public:
+    PCBLazyAgingTest() : TestFixture("PCB Lazy Aging test")
+    {
+    }
+
+    void test()
+    {
+        // eager: ageProcess on every waiting process per step. lazy: AgingEngine.
+        std::vector<PCB> eager;
+        for (int pid = 1; pid <= 8; pid++)
+        {
+            eager.emplace_back(pid, pid % 4 + 1, 10, false, 0, TEST_AGING, TEST_TIME);
+        }
+        std::vector<PCB> lazy = eager;
+
+        AgingEngine engine(lazy);
+        engine.reset();
+        for (size_t idx = 0; idx < lazy.size(); idx++)
+        {
+            engine.track(idx);
+        }
+
+        const int deltas[] = {1, 3, 0, 7, 2, 5, 11, 1, 4, 9, 3, 6, 2, 8, 1, 13};
+        size_t step = 0;
+        for (int delta : deltas)
+        {
+            size_t skip = step++ % eager.size();  // the process executed this step
+
+            std::vector<size_t> eager_promoted;
+            for (size_t idx = 0; idx < eager.size(); idx++)
+            {
+                if (idx != skip && eager[idx].ageProcess(delta))
+                {
+                    eager_promoted.push_back(idx);
+                }
+            }
+
+            const std::vector<size_t>& lazy_promoted = engine.advance(delta, skip);
+            assert_true(lazy_promoted == eager_promoted,
+                        " Lazy aging should promote the same processes in the same order");
+
+            // requeue the promoted, like the scheduler does
+            for (size_t idx : lazy_promoted)
+            {
+                engine.untrack(idx);
+                engine.track(idx);
+            }
+        }
+
+        for (size_t idx = 0; idx < lazy.size(); idx++)
+        {
+            engine.untrack(idx);
+            assert_equal(lazy[idx].getPriority(),
+                         eager[idx].getPriority(),
+                         " Lazy and eager aging should end with the same priority");
+            assert_equal(lazy[idx].getWaitingTime(),
+                         eager[idx].getWaitingTime(),
+                         " Lazy and eager aging should end with the same waiting time");
+        }
+    }
+};
+
+class PCBProcessTableTest : public TestFixture
+{
+   public:
+    PCBProcessTableTest() : TestFixture("PCB Process Table test")
+    {
+    }
+
+    void test()
+    {
+        std::vector<PCB> eager;
+        for (int pid = 1; pid <= 8; pid++)
+        {
+            eager.emplace_back(pid, pid % 4 + 1, 10, false, 0, TEST_AGING, TEST_TIME);
+        }
+        std::vector<PCB> pool = eager;
+
+        ProcessTable table(pool);
+        assert_equal(table.size(), pool.size(), " Table should have a row per process");
+        assert_equal(table.prio[3], pool[3].getPriority(), " Columns should be gathered");
+
+        const int deltas[] = {3, 7, 2, 11, 5, 9, 13, 1};
+        size_t step = 0;
+        for (int delta : deltas)
+        {
+            size_t skip = step++ % eager.size();
+
+            std::vector<size_t> eager_promoted;
+            for (size_t idx = 0; idx < eager.size(); idx++)
+            {
+                if (idx != skip && eager[idx].ageProcess(delta))
+                {
+                    eager_promoted.push_back(idx);
+                }
+            }
+
+            assert_true(table.ageReady(delta, skip) == eager_promoted,
+                        " Column aging should promote the same processes");
+        }
+
+        // the PCB view writes the row back
+        for (size_t idx = 0; idx < pool.size(); idx++)
+        {
+            PCB& p = table.pcb(idx);
+            assert_equal(p.getPriority(), eager[idx].getPriority(), " View should have the prio");
+            assert_equal(p.getWaitingTime(),
+                         eager[idx].getWaitingTime(),
+                         " View should have the waiting time");
+        }
+
+        pool[0].setState(ProcessState::WAITING_IO);
+        pool[0].setIOTime(5);
+        table.gather(0);
+        assert_true(table.advanceIO(3).empty(), " IO should not be finished after 3");
+        assert_equal(table.advanceIO(3).size(), 1, " IO should be finished after 6");
+        assert_true(table.pcb(0).isReady(), " Finished IO should make the process READY");
+        assert_equal(pool[0].getTotalIOTime(), 5, " Total IO time should be 5");
+    }
+};
+
+class PCBKernelTest : public TestFixture
+{
+   public:
+    PCBKernelTest() : TestFixture("PCB SIMD Kernel test")
+    {
+    }
+
+    void test()
+    {
+        // odd size, so every kernel also runs its scalar tail
+        std::vector<PCB> pool;
+        for (int pid = 1; pid <= 37; pid++)
+        {
+            pool.emplace_back(pid, pid % 5 + 1, 10, pid % 2 == 0, 6, TEST_AGING, TEST_TIME);
+            if (pid % 3 == 0)
+            {
+                pool.back().setState(ProcessState::WAITING_IO);
+                pool.back().setIOTime(pid % 7);
+            }
+        }
+
+        const KernelIsa best = detectKernelIsa();
+        std::vector<size_t> scalar_aged, scalar_io;
+        ProcessTable scalar_table(pool);
+        setKernelIsa(KernelIsa::SCALAR);
+        for (int step = 0; step < 12; step++)
+        {
+            const auto& aged = scalar_table.ageReady(step * 3 % 11, step * 5 % pool.size());
+            scalar_aged.insert(scalar_aged.end(), aged.begin(), aged.end());
+            const auto& io = scalar_table.advanceIO(step % 4);
+            scalar_io.insert(scalar_io.end(), io.begin(), io.end());
+        }
+
+        for (int isa = static_cast<int>(KernelIsa::SSE2); isa <= static_cast<int>(best); isa++)
+        {
+            assert_true(setKernelIsa(static_cast<KernelIsa>(isa)), " Supported ISA should be set");
+
+            std::vector<size_t> simd_aged, simd_io;
+            ProcessTable table(pool);
+            for (int step = 0; step < 12; step++)
+            {
+                const auto& aged = table.ageReady(step * 3 % 11, step * 5 % pool.size());
+                simd_aged.insert(simd_aged.end(), aged.begin(), aged.end());
+                const auto& io = table.advanceIO(step % 4);
+                simd_io.insert(simd_io.end(), io.begin(), io.end());
+            }
+
+            assert_true(simd_aged == scalar_aged, " Kernel should promote like the scalar path");
+            assert_true(simd_io == scalar_io, " Kernel should finish IO like the scalar path");
+            assert_true(table.prio == scalar_table.prio &&
+                            table.waiting_time == scalar_table.waiting_time &&
+                            table.io_remaining == scalar_table.io_remaining &&
+                            table.total_io_time == scalar_table.total_io_time &&
+                            table.state == scalar_table.state,
+                        " Kernel columns should match the scalar path");
+        }
+
+        setKernelIsa(best);
+    }
+};
+
 void run_PCB_tests()
 {
     std::cout << "\n==== PCB Test ====\n";
@@ -129,6 +318,42 @@ void run_PCB_tests()
         std::cout << "Exception raised in [AGE TEST] with: " << e.what() << std::endl;
         failed++;
     }
+
+    try
+    {
+        PCBLazyAgingTest test4;
+        test4.run([&]() { test4.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [LAZY AGING TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        PCBProcessTableTest test5;
+        test5.run([&]() { test5.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [PROCESS TABLE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        PCBKernelTest test6;
+        test6.run([&]() { test6.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [KERNEL TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
     std::cout << "PCB test passed with: " << passed << " passed , " << failed << " failed"
               << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "MultiLevelQueue.h"
+#include "TestFixture.h"
+
+const int TEST_LEVELS = 10;
+
+class QueueHighestLevelTest : public TestFixture
+{
+   public:
+    QueueHighestLevelTest() : TestFixture("Multi Level Queue Highest Level Test")
+    {
+    }
+
+    void test()
+    {
+        MultiLevelQueue mlq;
+        mlq.resize(TEST_LEVELS);
+
+        assert_true(mlq.empty(), " Queue should start empty");
+        assert_equal(mlq.highestLevel(),
+                     PriorityBitmap::NO_LEVEL,
+                     " Empty queue should have no highest level");
+
+        mlq.push(7, 0);
+        mlq.push(3, 1);
+        mlq.push(TEST_LEVELS, 2);
+        assert_equal(mlq.highestLevel(), 3, " Level 3 should be the highest level with work");
+
+        assert_equal(mlq.pop(3), 1, " Level 3 should pop index 1");
+        assert_true(mlq.empty(3), " Level 3 should be empty after the pop");
+        assert_equal(mlq.highestLevel(), 7, " Level 7 should now be the highest level");
+
+        assert_true(mlq.remove(7, 0), " Index 0 should be removed from level 7");
+        assert_equal(mlq.highestLevel(),
+                     TEST_LEVELS,
+                     " The lowest priority level should now be the highest level");
+
+        mlq.pop(TEST_LEVELS);
+        assert_true(mlq.empty(), " Queue should be empty again");
+    }
+};
+
+class QueueFifoTest : public TestFixture
+{
+   public:
+    QueueFifoTest() : TestFixture("Multi Level Queue FIFO Test")
+    {
+    }
+
+    void test()
+    {
+        MultiLevelQueue mlq;
+        mlq.resize(TEST_LEVELS);
+
+        for (size_t idx = 0; idx < 5; idx++)
+        {
+            mlq.push(2, idx);
+        }
+
+        assert_true(mlq.remove(2, 2), " Index 2 should be removed");
+        assert_true(!mlq.remove(2, 2), " Index 2 should not be removed twice");
+        assert_true(!mlq.contains(2, 2), " Index 2 should be gone");
+        assert_true(mlq.contains(2, 3), " Index 3 should still be queued");
+        assert_equal(mlq.size(2), 4, " Level 2 should hold 4 indices");
+
+        std::vector<size_t> expected = {0, 1, 3, 4};
+        assert_true(mlq.toVector(2) == expected, " Level 2 should keep its FIFO order");
+
+        // unlinking the head and the tail keeps the links intact
+        assert_true(mlq.remove(2, 0), " Head index 0 should be removed");
+        assert_true(mlq.remove(2, 4), " Tail index 4 should be removed");
+        assert_equal(mlq.front(2), 1, " Index 1 should now be the head of level 2");
+        assert_equal(mlq.levelOf(3), 2, " Index 3 should be queued at level 2");
+        assert_equal(mlq.levelOf(4), MultiLevelQueue::NOT_QUEUED, " Index 4 should not be queued");
+
+        bool rejected = false;
+        try
+        {
+            mlq.push(5, 3);
+        }
+        catch (std::runtime_error&)
+        {
+            rejected = true;
+        }
+        assert_true(rejected, " An index can only be queued once");
+
+        mlq.push(5, 4);
+        assert_equal(mlq.pop(2), 1, " Level 2 should pop index 1");
+        assert_equal(mlq.pop(2), 3, " Level 2 should pop index 3");
+        assert_equal(mlq.highestLevel(), 5, " Level 5 should now be the highest level");
+    }
+};
+
+class QueueManyLevelsTest : public TestFixture
+{
+   public:
+    QueueManyLevelsTest() : TestFixture("Multi Level Queue Many Levels Test")
+    {
+    }
+
+    void test()
+    {
+        const int levels = 1024;
+        MultiLevelQueue mlq;
+        mlq.resize(levels);
+
+        // spread over several bitmap words
+        mlq.push(levels, 0);
+        mlq.push(700, 1);
+        mlq.push(64, 2);
+        mlq.push(63, 3);
+
+        assert_equal(mlq.highestLevel(), 63, " Level 63 should be the highest level");
+        assert_equal(mlq.nextLevel(63), 64, " Level 64 should follow level 63");
+        assert_equal(mlq.nextLevel(64), 700, " Level 700 should follow level 64");
+        assert_equal(mlq.nextLevel(700), levels, " The last level should follow level 700");
+        assert_equal(mlq.nextLevel(levels),
+                     PriorityBitmap::NO_LEVEL,
+                     " Nothing should follow the last level");
+
+        mlq.pop(63);
+        mlq.pop(64);
+        assert_equal(mlq.highestLevel(), 700, " Level 700 should now be the highest level");
+
+        mlq.pop(700);
+        mlq.pop(levels);
+        assert_true(mlq.empty(), " Queue should be empty again");
+    }
+};
+
+void run_queue_tests()
+{
+    std::cout << "\n==== Queue Test ====\n";
+    int passed = 0, failed = 0;
+
+    try
+    {
+        QueueHighestLevelTest test1;
+        test1.run([&]() { test1.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [HIGHEST LEVEL TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        QueueFifoTest test2;
+        test2.run([&]() { test2.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [FIFO TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        QueueManyLevelsTest test3;
+        test3.run([&]() { test3.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [MANY LEVELS TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    std::cout << "Queue test passed with: " << passed << " passed , " << failed << " failed"
+              << std::endl;
+}
@@ -0,0 +1,219 @@
+#include <LogsJson.h>
+
+#include <fstream>
+
+#include "MultiLevelQueue.h"
+#include "SchedulerClass.h"
+#include "TestFixture.h"
+
+const size_t SCALE_QUEUE_SIZE = 1000000;
+const int SCALE_QUEUE_LEVELS = 140;
+const int SCALE_SCHEDULER_SIZE = 250;  // above the old MAX_PROCESS_SIZE = 100 limit
+const int SCALE_MILLION_SIZE = 1000000;
+
+class ScaleReadyQueueTest : public TestFixture
+{
+   public:
+    ScaleReadyQueueTest() : TestFixture("Ready Queue 1M Scale Test")
+    {
+    }
+
+    void test()
+    {
+        // the scheduler's ready queues, 1M process indexes spread over the levels
+        MultiLevelQueue rq;
+        rq.resize(SCALE_QUEUE_LEVELS);
+        rq.reserve(SCALE_QUEUE_SIZE);
+        assert_true(rq.empty(), "Queue should start empty");
+
+        for (size_t i = 0; i < SCALE_QUEUE_SIZE; i++)
+        {
+            rq.push(static_cast<int>(i % SCALE_QUEUE_LEVELS) + 1, i);
+        }
+        size_t queued = 0;
+        for (int level = 1; level <= SCALE_QUEUE_LEVELS; level++)
+            queued += rq.size(level);
+        assert_equal(queued, SCALE_QUEUE_SIZE, " Queues should hold 1M elements");
+        assert_equal(rq.highestLevel(), 1, " Level 1 should be the highest non-empty level");
+        assert_equal(rq.front(1), 0, " Front should be the first pushed element");
+
+        // remove from the front, the middle and the back of level 1
+        size_t middle = SCALE_QUEUE_SIZE / 2 / SCALE_QUEUE_LEVELS * SCALE_QUEUE_LEVELS;
+        size_t back = (SCALE_QUEUE_SIZE - 1) / SCALE_QUEUE_LEVELS * SCALE_QUEUE_LEVELS;
+        assert_true(rq.remove(1, 0), "Front element should be removed");
+        assert_true(rq.remove(1, middle), "Middle element should be removed");
+        assert_true(rq.remove(1, back), "Back element should be removed");
+        assert_true(!rq.contains(1, middle), "Removed element should be gone");
+        assert_true(!rq.remove(2, SCALE_QUEUE_LEVELS), "Element of another level stays");
+
+        // FIFO order per level must be intact after the removals, highest level drained first
+        std::vector<size_t> next(SCALE_QUEUE_LEVELS + 1);
+        for (int level = 1; level <= SCALE_QUEUE_LEVELS; level++)
+            next[level] = static_cast<size_t>(level - 1);
+        auto removed = [&](size_t value) { return value == 0 || value == middle || value == back; };
+
+        size_t popped = 0;
+        int last_level = 1;
+        while (!rq.empty())
+        {
+            int level = rq.highestLevel();
+            assert_true(level >= last_level, " Levels should drain highest priority first");
+            last_level = level;
+
+            while (removed(next[level]))
+                next[level] += SCALE_QUEUE_LEVELS;
+
+            size_t value = rq.pop(level);
+            if (value != next[level])
+            {
+                assert_equal(value, next[level], " Queue lost its FIFO order");
+            }
+            next[level] += SCALE_QUEUE_LEVELS;
+            popped++;
+        }
+        assert_equal(popped, SCALE_QUEUE_SIZE - 3, " All elements should have been popped");
+    }
+};
+
+class ScaleSchedulerTest : public TestFixture
+{
+   public:
+    ScaleSchedulerTest() : TestFixture("Scheduler Process Ceiling Test")
+    {
+    }
+
+    void test()
+    {
+        std::string configfile = "scale_config";
+        std::string logfile = "scale_test";
+        trackFile(extensionJSON(configfile));
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+
+        // clang-format off
+        json summary;
+        summary["scheduler_config"] = {{"aging_threshold", 5},
+                                       {"max_priority", 3},
+                                       {"time_quantum", 4},
+                                       {"context_switch_time", 1}};
+        // clang-format on
+
+        summary["processes"] = json::array();
+        for (int pid = 1; pid <= SCALE_SCHEDULER_SIZE; pid++)
+        {
+            summary["processes"].push_back({{"pid", pid},
+                                            {"priority", pid % 3 + 1},
+                                            {"burst_time", pid % 7 + 1},
+                                            {"io_bound", pid % 2 == 0},
+                                            {"io_interval", pid % 2 == 0 ? 3 : 0}});
+        }
+        appendToJSON_object(configfile, summary);
+
+        Scheduler scheduler(logfile, configfile);
+        scheduler.run();
+
+        assert_true(fileExists(logfile + "_metrics"), "Metrics file should exist");
+    }
+};
+
+class ScaleSchedulerMillionTest : public TestFixture
+{
+   public:
+    ScaleSchedulerMillionTest() : TestFixture("Scheduler 1M Process Test")
+    {
+    }
+
+    void test()
+    {
+        std::string configfile = "scale_million_config";
+        std::string logfile = "scale_million_test";
+        trackFile(extensionJSON(configfile));
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+
+        // written as text, a json DOM of 1M processes would dominate the test. Only a sample of
+        // the finished events is logged, to keep the event log small.
+        long long total_burst = 0;
+        {
+            std::ofstream out(makeLogPath(configfile));
+            out << R"({"scheduler_config": {"aging_threshold": 5, "max_priority": 140,)"
+                << R"( "time_quantum": 4, "context_switch_time": 1, "log_policy":)"
+                << R"( {"events": ["FINISHED"], "sample_every": 1000}}, "processes": [)";
+            for (int pid = 1; pid <= SCALE_MILLION_SIZE; pid++)
+            {
+                int burst = pid % 7 + 1;
+                total_burst += burst;
+                out << (pid > 1 ? ",\n" : "\n") << R"({"pid": )" << pid
+                    << R"(, "priority": )" << pid % 140 + 1 << R"(, "burst_time": )" << burst
+                    << R"(, "io_bound": )" << (pid % 2 == 0 ? "true" : "false")
+                    << R"(, "io_interval": )" << (pid % 2 == 0 ? 3 : 0) << "}";
+            }
+            out << "]}\n";
+        }
+
+        Scheduler scheduler(logfile, configfile);
+        scheduler.run();
+
+        SystemMetrics metrics = scheduler.getMetricsSnapshot();
+        assert_equal(metrics.total_processes, SCALE_MILLION_SIZE, " Every process should load");
+        assert_equal(metrics.completed_processes,
+                     SCALE_MILLION_SIZE,
+                     " Every process should complete");
+        assert_true(metrics.total_time >= total_burst, " Total time should cover every burst");
+        assert_true(metrics.cpu_utilization > 0 && metrics.cpu_utilization <= 100,
+                    " CPU utilization should be a percentage");
+        assert_true(metrics.turnaround_percentiles.p50 <= metrics.turnaround_percentiles.p99,
+                    " Turnaround percentiles should be ordered");
+        assert_true(fileExists(logfile + "_metrics"), "Metrics file should exist");
+    }
+};
+
+// full_scale adds the 1M process scheduler run (test_scheduler --scale, make test-scale)
+void run_scale_tests(bool full_scale)
+{
+    std::cout << "\n==== Scale Test ====\n";
+    int passed = 0, failed = 0;
+
+    try
+    {
+        ScaleReadyQueueTest test1;
+        test1.run([&]() { test1.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [READY QUEUE SCALE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ScaleSchedulerTest test2;
+        test2.run([&]() { test2.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [SCHEDULER SCALE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    if (full_scale)
+    {
+        try
+        {
+            ScaleSchedulerMillionTest test3;
+            test3.run([&]() { test3.test(); });
+            passed++;
+        }
+        catch (std::exception& e)
+        {
+            std::cout << "Exception raised in [SCHEDULER 1M SCALE TEST] with: " << e.what()
+                      << std::endl;
+            failed++;
+        }
+    }
+
+    std::cout << "Scale test passed with: " << passed << " passed , " << failed << " failed"
+              << std::endl;
+}
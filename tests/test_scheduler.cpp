@@ -1,4 +1,13 @@
 #include <LogsJson.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <thread>
 
 #include "SchedulerClass.h"
 #include "TestFixture.h"
@@ -15,12 +24,13 @@ class SchedulerConstructionTest : public TestFixture
     void test()
     {
         std::string logfile = "test_construction";
-        trackFile(logfile);
+        std::string eventfile = extensionNDJSON(logfile);
+        trackFile(eventfile);
 
         assert_true(std::filesystem::exists(config_path), "Config path must exist");
 
         Scheduler schedule(logfile, config_path.string());
-        assert_true(fileExists(logfile), "Logfile doesnt exist");
+        assert_true(fileExists(eventfile), "Logfile doesnt exist");
     }
 };
 
@@ -34,7 +44,7 @@ class SchedulerDebugTest : public TestFixture
     void test()
     {
         std::string logfile = "debug_test";
-        trackFile(logfile);
+        trackFile(extensionNDJSON(logfile));
 
         assert_true(std::filesystem::exists(config_path), "Config path must exist");
 
@@ -61,15 +71,702 @@ class SchedulerFullRunTest : public TestFixture
     void test()
     {
         std::string logfile = "full_test";
-        trackFile(logfile);
+        std::string eventfile = extensionNDJSON(logfile);
+        trackFile(eventfile);
 
         assert_true(std::filesystem::exists(config_path), "Config path must exist");
 
         Scheduler scheduler(logfile, config_path.string());
 
         scheduler.run();
-        assert_true(fileExists(logfile), "Log file doesnt exists");
-        assert_true(countLines(logfile) > 0, "Log file contains lines");
+        assert_true(fileExists(eventfile), "Log file doesnt exists");
+        assert_true(countLines(eventfile) > 0, "Log file contains lines");
+    }
+};
+
+class EventCalendarOrderTest : public TestFixture
+{
+   public:
+    EventCalendarOrderTest() : TestFixture("Event Calendar Order Test")
+    {
+    }
+
+    void test()
+    {
+        EventCalendar calendar;
+        assert_true(calendar.empty(), "Calendar should start empty");
+
+        calendar.schedule(10, EventType::QUANTUM_EXPIRY, 0);
+        calendar.schedule(4, EventType::IO_COMPLETION, 1);
+        calendar.schedule(4, EventType::IO_COMPLETION, 2);
+        calendar.schedule(0, EventType::ARRIVAL, 3);
+        calendar.schedule(10, EventType::AGING_PROMOTION, 4);
+
+        assert_equal(calendar.size(), 5, "Calendar should hold 5 events");
+        assert_equal(calendar.nextTime(), 0, "Arrival should be the first event");
+
+        // by time, then in the order they were scheduled
+        const size_t expected_idx[] = {3, 1, 2, 0, 4};
+        const long long expected_time[] = {0, 4, 4, 10, 10};
+        for (size_t n = 0; n < 5; n++)
+        {
+            Event ev = calendar.pop();
+            assert_equal(ev.idx, expected_idx[n], "Events should come in (time, seq) order");
+            assert_equal(ev.time, expected_time[n], "Events should come in time order");
+        }
+        assert_true(calendar.empty(), "Calendar should be empty after popping every event");
+    }
+};
+
+class NdjsonWriterTest : public TestFixture
+{
+   public:
+    NdjsonWriterTest() : TestFixture("NDJSON Writer Test")
+    {
+    }
+
+    void test()
+    {
+        std::string logfile = extensionNDJSON("ndjson_test");
+        trackFile(logfile);
+
+        // small buffer, so writes also go out before the explicit flush
+        NdjsonWriter writer(64);
+        assert_true(writer.open(makeLogPath(logfile)), "Writer should open the log file");
+
+        for (int pid = 1; pid <= 20; pid++)
+        {
+            writer.write({{"pid", pid}, {"prio", pid % 3}, {"event", 0}});
+        }
+        writer.flush();
+        assert_equal(writer.getWrittenEvents(), 20, " Writer should have written 20 events");
+        assert_equal(writer.getBufferedBytes(), 0, " Nothing should be buffered after flush");
+
+        // valid after the flush, while the writer is still open
+        std::ifstream in(makeLogPath(logfile));
+        std::string line;
+        int pid = 0;
+        while (std::getline(in, line))
+        {
+            json entry = json::parse(line);
+            assert_equal(entry["pid"].get<int>(), ++pid, " Events should be in write order");
+        }
+        assert_equal(pid, 20, " Log file should have a line per event");
+    }
+};
+
+class BinaryTraceTest : public TestFixture
+{
+   public:
+    BinaryTraceTest() : TestFixture("Binary Trace Test")
+    {
+    }
+
+    void test()
+    {
+        std::string jsonlog = "trace_json_test";
+        std::string binlog = "trace_bin_test";
+        std::string converted = extensionNDJSON("trace_converted_test");
+        trackFile(extensionNDJSON(jsonlog));
+        trackFile(binlog + ".trace");
+        trackFile(converted);
+        trackFile(extensionJSON(jsonlog + "_metrics"));
+        trackFile(extensionJSON(binlog + "_metrics"));
+
+        Scheduler json_run(jsonlog, config_path.string());
+        json_run.run();
+        Scheduler bin_run(binlog, config_path.string(), Scheduler::LogFormat::BINARY);
+        bin_run.run();
+
+        std::vector<TraceRecord> records = readTrace(makeTracePath(binlog));
+        size_t count = convertTraceToNdjson(makeTracePath(binlog), makeLogPath(converted));
+        assert_equal(count, records.size(), " Converter should convert every record");
+        assert_true(count > 0, " Trace should contain records");
+
+        // the converted trace has the same events as the NDJSON log
+        std::ifstream expected(makeLogPath(extensionNDJSON(jsonlog)));
+        std::ifstream actual(makeLogPath(converted));
+        std::string a, b;
+        size_t lines = 0;
+        while (std::getline(expected, a))
+        {
+            assert_true(std::getline(actual, b) && json::parse(a) == json::parse(b),
+                        " Converted event should match the NDJSON event");
+            lines++;
+        }
+        assert_equal(lines, count, " NDJSON log and trace should have the same events");
+
+        for (size_t i = 1; i < records.size(); i++)
+        {
+            assert_true(records[i - 1].timestamp <= records[i].timestamp,
+                        " Trace timestamps should not go back");
+        }
+    }
+};
+
+class AsyncLogTest : public TestFixture
+{
+   public:
+    AsyncLogTest() : TestFixture("Async Log Writer Test")
+    {
+    }
+
+    void test()
+    {
+        // slow sink with tiny batches, so the producer has to wait for free batches
+        std::vector<int> pids;
+        int flushes = 0;
+        AsyncLogWriter writer(
+            [&pids](const TraceRecord* records, size_t count)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                for (size_t i = 0; i < count; i++)
+                {
+                    pids.push_back(records[i].pid);
+                }
+            },
+            [&flushes]() { flushes++; },
+            8,
+            2);
+
+        for (int pid = 1; pid <= 200; pid++)
+        {
+            TraceRecord record{};
+            record.pid = pid;
+            writer.write(record);
+        }
+        writer.flush();
+
+        // everything is written once flush returns
+        assert_equal(pids.size(), 200, " Writer thread should have written 200 records");
+        for (int i = 0; i < 200; i++)
+        {
+            assert_equal(pids[i], i + 1, " Records should be written in order");
+        }
+        assert_equal(flushes, 1, " Sink should be flushed once");
+
+        AsyncLogStats stats = writer.getStats();
+        assert_equal(stats.records, 200, " Stats should count 200 records");
+        assert_equal(stats.batches, 26, " 25 full batches and the flushed one");
+        assert_true(stats.producer_waits > 0, " Producer should have waited for the slow sink");
+        writer.close();
+
+        // async and sync logging give the same event log
+        std::string synclog = "sync_log_test";
+        std::string asynclog = "async_log_test";
+        trackFile(extensionNDJSON(synclog));
+        trackFile(extensionNDJSON(asynclog));
+        trackFile(extensionJSON(synclog + "_metrics"));
+        trackFile(extensionJSON(asynclog + "_metrics"));
+
+        Scheduler sync_run(synclog, config_path.string());
+        sync_run.run();
+        Scheduler async_run(asynclog, config_path.string());
+        async_run.enableAsyncLogging(4, 2);
+        async_run.run();
+
+        std::ifstream expected(makeLogPath(extensionNDJSON(synclog)));
+        std::ifstream actual(makeLogPath(extensionNDJSON(asynclog)));
+        std::string a, b;
+        int lines = 0;
+        while (std::getline(expected, a))
+        {
+            assert_true(std::getline(actual, b) && a == b, " Async event should match sync event");
+            lines++;
+        }
+        assert_true(!std::getline(actual, b), " Async log should have no extra events");
+        assert_equal(async_run.getAsyncLogStats()->records, lines, " Stats should count events");
+    }
+};
+
+class LogMemoryCapTest : public TestFixture
+{
+   public:
+    LogMemoryCapTest() : TestFixture("Log Memory Cap Test")
+    {
+    }
+
+    void test()
+    {
+        std::string logfile = extensionNDJSON("memory_cap_test");
+        trackFile(logfile);
+
+        // at most 4 events or 200 bytes in memory
+        NdjsonWriter writer;
+        writer.setCap(4, 200);
+        writer.open(makeLogPath(logfile));
+        for (int pid = 1; pid <= 100; pid++)
+        {
+            writer.write({{"pid", pid}});
+            assert_true(writer.getBufferedBytes() < 200, " Buffer should stay under the byte cap");
+        }
+        assert_equal(writer.getSpills(), 25, " Every 4th event should spill");
+        assert_true(writer.getPeakBufferedBytes() <= 200, " Peak buffer should stay under the cap");
+        writer.close();
+
+        // spilling doesn't change the log
+        std::string fulllog = "uncapped_log_test";
+        std::string caplog = "capped_log_test";
+        trackFile(extensionNDJSON(fulllog));
+        trackFile(extensionNDJSON(caplog));
+        trackFile(extensionJSON(fulllog + "_metrics"));
+        trackFile(extensionJSON(caplog + "_metrics"));
+
+        Scheduler full_run(fulllog, config_path.string());
+        full_run.run();
+        Scheduler cap_run(caplog, config_path.string());
+        cap_run.setLogMemoryCap(3);
+        cap_run.run();
+
+        assert_equal(full_run.getLogSpills(), 0, " Uncapped run should not spill");
+        assert_true(cap_run.getLogSpills() > 0, " Capped run should spill");
+
+        std::ifstream expected(makeLogPath(extensionNDJSON(fulllog)));
+        std::ifstream actual(makeLogPath(extensionNDJSON(caplog)));
+        std::string a, b;
+        while (std::getline(expected, a))
+        {
+            assert_true(std::getline(actual, b) && a == b, " Capped event should match");
+        }
+        assert_true(!std::getline(actual, b), " Capped log should have no extra events");
+    }
+};
+
+class MmapTraceTest : public TestFixture
+{
+   public:
+    MmapTraceTest() : TestFixture("Mmap Trace Test")
+    {
+    }
+
+    void test()
+    {
+        std::string tracefile = "mmap_trace_test.trace";
+        trackFile(tracefile);
+
+        // one page segments, so the writer has to move through several of them
+        MmapTraceWriter writer(4096);
+        assert_true(writer.open(makeTracePath(tracefile)), "Writer should open the trace");
+        for (int pid = 1; pid <= 1000; pid++)
+        {
+            TraceRecord record{};
+            record.pid = pid;
+            record.timestamp = pid * 10;
+            writer.write(record);
+        }
+        assert_true(writer.getSegments() > 1, " Writer should have used several segments");
+        writer.close();
+
+        assert_equal(std::filesystem::file_size(makeTracePath(tracefile)),
+                     sizeof(TraceHeader) + 1000 * sizeof(TraceRecord),
+                     " Trace should be truncated to the used length");
+
+        std::vector<TraceRecord> records = readTrace(makeTracePath(tracefile));
+        assert_equal(records.size(), 1000, " Trace should hold 1000 records");
+        for (int i = 0; i < 1000; i++)
+        {
+            assert_equal(records[i].pid, i + 1, " Records should be read back in order");
+        }
+
+        // the scheduler writes the same trace through either writer
+        std::string filelog = "stream_trace_test";
+        std::string mmaplog = "mmap_sched_trace_test";
+        trackFile(filelog + ".trace");
+        trackFile(mmaplog + ".trace");
+        trackFile(extensionJSON(filelog + "_metrics"));
+        trackFile(extensionJSON(mmaplog + "_metrics"));
+
+        Scheduler file_run(filelog, config_path.string(), Scheduler::LogFormat::BINARY);
+        file_run.run();
+        Scheduler mmap_run(mmaplog, config_path.string(), Scheduler::LogFormat::BINARY_MMAP);
+        mmap_run.run();
+
+        std::vector<TraceRecord> expected = readTrace(makeTracePath(filelog));
+        std::vector<TraceRecord> actual = readTrace(makeTracePath(mmaplog));
+        assert_equal(actual.size(), expected.size(), " Both traces should have the same events");
+        assert_true(std::memcmp(actual.data(),
+                                expected.data(),
+                                expected.size() * sizeof(TraceRecord)) == 0,
+                    " Both traces should have the same records");
+    }
+};
+
+class LogPolicyTest : public TestFixture
+{
+   public:
+    LogPolicyTest() : TestFixture("Log Policy Test")
+    {
+    }
+
+    std::vector<TraceRecord> runWithPolicy(const std::string& logfile, const LogPolicy& policy)
+    {
+        trackFile(logfile + ".trace");
+        trackFile(extensionJSON(logfile + "_metrics"));
+
+        Scheduler scheduler(logfile, config_path.string(), Scheduler::LogFormat::BINARY);
+        scheduler.setLogPolicy(policy);
+        scheduler.run();
+        scheduler.flushLogs();
+        return readTrace(makeTracePath(logfile));
+    }
+
+    void test()
+    {
+        std::vector<TraceRecord> all = runWithPolicy("policy_all_test", LogPolicy{});
+
+        // FINISHED only, one event per process
+        LogPolicy finished;
+        finished.event_mask = LOG_EVENT_FINISHED;
+        std::vector<TraceRecord> done = runWithPolicy("policy_finished_test", finished);
+        assert_equal(done.size(), 3, " Every process should finish once");
+        for (const auto& r : done)
+        {
+            assert_equal(r.event, static_cast<uint8_t>(TraceEvent::FINISHED), " Only FINISHED");
+        }
+
+        // PID allowlist
+        LogPolicy allowlist;
+        allowlist.pids = {2};
+        std::vector<TraceRecord> pid2 = runWithPolicy("policy_pid_test", allowlist);
+        size_t expected = std::ranges::count(all, 2, &TraceRecord::pid);
+        assert_equal(pid2.size(), expected, " Every event of PID 2 should be logged");
+        assert_true(std::ranges::all_of(pid2, [](const auto& r) { return r.pid == 2; }),
+                    " Only PID 2 should be logged");
+
+        // state transitions only, no two events of the same type in a row per process
+        LogPolicy transitions;
+        transitions.transitions_only = true;
+        std::vector<TraceRecord> changed = runWithPolicy("policy_transitions_test", transitions);
+        assert_true(changed.size() < all.size(), " Repeated events should be dropped");
+        std::map<int, uint8_t> last;
+        for (const auto& r : changed)
+        {
+            assert_true(!last.contains(r.pid) || last[r.pid] != r.event,
+                        " Logged events should be transitions");
+            last[r.pid] = r.event;
+        }
+
+        // 1 in 2 sampling keeps every second event
+        LogPolicy sampled;
+        sampled.sample_every = 2;
+        std::vector<TraceRecord> half = runWithPolicy("policy_sample_test", sampled);
+        assert_equal(half.size(), all.size() / 2, " Every second event should be logged");
+        for (size_t i = 0; i < half.size(); i++)
+        {
+            assert_equal(half[i].timestamp, all[2 * i + 1].timestamp, " Sampled event mismatch");
+        }
+    }
+};
+
+class DebugSinkTest : public TestFixture
+{
+    static inline std::atomic<int> chained_signals{0};  // lock free, signal safe
+
+   public:
+    DebugSinkTest() : TestFixture("Debug Sink Test")
+    {
+    }
+
+    std::vector<std::string> readLines(const std::string& file)
+    {
+        std::ifstream in(makeLogPath(file));
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(in, line))
+            lines.push_back(line);
+        return lines;
+    }
+
+    void test()
+    {
+        std::string drainfile = "debug_drain_test";
+        std::string dumpfile = "debug_dump_test";
+        std::string runfile = "debug_run_test";
+        trackFile(extensionJSON(drainfile));
+        trackFile(extensionJSON(dumpfile));
+        trackFile(extensionJSON(runfile));
+
+        // small ring, so the writer has to wait for the drain thread, nothing may be lost
+        int fd = ::open(makeLogPath(drainfile).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        {
+            DebugSink sink(DebugSink::Mode::DRAIN, 256, fd);
+            for (int n = 0; n < 1000; n++)
+                sink.write("line " + std::to_string(n));
+            assert_equal(sink.getStats().lines, 1000, " Sink should count 1000 lines");
+        }
+        ::close(fd);
+        std::vector<std::string> drained = readLines(drainfile);
+        assert_equal(drained.size(), 1000, " Every line should be drained");
+        for (int n = 0; n < 1000; n++)
+            assert_true(drained[n] == "line " + std::to_string(n), " Lines should keep order");
+
+        // flight recorder, only the newest whole lines are kept and dumped
+        fd = ::open(makeLogPath(dumpfile).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        {
+            DebugSink sink(DebugSink::Mode::DUMP_ON_EXIT, 256, fd);
+            for (int n = 0; n < 1000; n++)
+                sink.write("line " + std::to_string(n));
+            assert_true(sink.getBufferedBytes() <= 256, " Ring should stay within its capacity");
+            assert_true(sink.getStats().dropped_bytes > 0, " Old lines should be overwritten");
+        }
+        ::close(fd);
+        std::vector<std::string> dumped = readLines(dumpfile);
+        assert_true(!dumped.empty() && dumped.size() < 1000, " Only the newest lines are dumped");
+        assert_true(dumped.back() == "line 999", " Last line should be the newest");
+        assert_true(dumped.front().starts_with("line "), " Dump should start at a whole line");
+
+        // crash handlers chain to the handler installed before and are restored afterwards
+        struct sigaction previous{};
+        struct sigaction counting{};
+        counting.sa_handler = [](int) { chained_signals++; };
+        sigemptyset(&counting.sa_mask);
+        sigaction(SIGFPE, &counting, &previous);
+        chained_signals = 0;
+        std::string crashfile = "debug_crash_test";
+        trackFile(extensionJSON(crashfile));
+        fd = ::open(makeLogPath(crashfile).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        {
+            DebugSink older(DebugSink::Mode::DUMP_ON_EXIT, 256, fd);
+            older.write("older sink");
+            struct sigaction installed{};
+            sigaction(SIGFPE, nullptr, &installed);
+            assert_true(installed.sa_handler != counting.sa_handler,
+                        " Sink should install its crash handler");
+            {
+                // a newer sink going away must not stop the older one from being dumped
+                DebugSink newer(DebugSink::Mode::DUMP_ON_EXIT, 256, fd);
+            }
+            std::raise(SIGFPE);
+            assert_equal(chained_signals, 1, " Crash handler should chain to the previous one");
+            assert_true(readLines(crashfile) == std::vector<std::string>{"older sink"},
+                        " Crash handler should dump the older sink");
+        }
+        ::close(fd);
+        struct sigaction restored{};
+        sigaction(SIGFPE, nullptr, &restored);
+        assert_true(restored.sa_handler == counting.sa_handler,
+                    " Previous handler should be restored with the last sink");
+        sigaction(SIGFPE, &previous, nullptr);
+
+        // scheduler debug output through the sink
+        std::string logfile = "debug_sink_run_test";
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+        fd = ::open(makeLogPath(runfile).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        size_t lines = 0;
+        {
+            Scheduler scheduler(logfile, config_path.string());
+            scheduler.setDebugFlags(Scheduler::ALL);
+            scheduler.enableDebugSink(DebugSink::Mode::DRAIN, 4096, fd);
+            scheduler.run();
+            lines = scheduler.getDebugSinkStats()->lines;
+        }
+        ::close(fd);
+        assert_true(lines > 0, " Scheduler should write debug lines to the sink");
+        assert_true(readLines(runfile).size() >= lines, " Every debug line should be output");
+    }
+};
+
+class ChromeTraceTest : public TestFixture
+{
+   public:
+    ChromeTraceTest() : TestFixture("Chrome Trace Test")
+    {
+    }
+
+    void test()
+    {
+        // the buffer stays bounded, however many events are written
+        std::string tracefile = "chrome_writer_test";
+        trackFile(extensionJSON(tracefile));
+        {
+            ChromeTraceWriter writer(4096);
+            assert_true(writer.open(makeLogPath(tracefile)), "Writer should open the trace");
+            for (int n = 0; n < 100000; n++)
+            {
+                writer.cpuSlice(0, n % 50 + 1, 1, n * 4, 4);
+                assert_true(writer.getBufferedBytes() < 4096, " Buffer should stay bounded");
+            }
+        }
+        json written = json::parse(std::ifstream(makeLogPath(tracefile)));
+        assert_equal(written.size(), 100003, " 100000 slices and 3 metadata events");
+
+        // scheduler timeline, one slice per executed quantum and matched IO waits
+        std::string logfile = "chrome_trace_test";
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+        trackFile(extensionJSON(logfile + "_timeline"));
+        {
+            Scheduler scheduler(logfile, config_path.string());
+            scheduler.enableChromeTrace();
+            scheduler.run();
+        }
+
+        json timeline = json::parse(std::ifstream(makeLogPath(logfile + "_timeline")));
+        int burst = 0, begins = 0, ends = 0;
+        long long cpu_free_at = 0;
+        for (const auto& ev : timeline)
+        {
+            std::string ph = ev["ph"];
+            if (ph == "X")
+            {
+                long long ts = ev["ts"], dur = ev["dur"];
+                assert_true(ts >= cpu_free_at, " CPU slices should not overlap");
+                cpu_free_at = ts + dur;
+                if (ev["name"] != "context switch")
+                    burst += static_cast<int>(dur);
+            }
+            else if (ph == "b")
+                begins++;
+            else if (ph == "e")
+                ends++;
+        }
+        assert_equal(burst, 10 + 8 + 22, " Slices should cover every burst time unit");
+        assert_true(begins > 0, " IO bound processes should have IO waits");
+        assert_equal(begins, ends, " Every IO wait should end");
+
+        // with async logging the timeline is flushed at the end of the run too
+        {
+            Scheduler scheduler(logfile, config_path.string());
+            scheduler.enableAsyncLogging();
+            scheduler.enableChromeTrace();
+            scheduler.run();
+            assert_true(std::filesystem::file_size(makeLogPath(logfile + "_timeline")) > 0,
+                        " Timeline should be flushed when the run ends");
+        }
+    }
+};
+
+class IncrementalMetricsTest : public TestFixture
+{
+   public:
+    IncrementalMetricsTest() : TestFixture("Incremental Metrics Test")
+    {
+    }
+
+    void test()
+    {
+        // CPU bound processes run back to back: 4 completes at 4, 6 at 10, 10 at 20.
+        std::vector<PCB> pool;
+        pool.emplace_back(1, 1, 4, false, 0, 5, 4);
+        pool.emplace_back(2, 1, 6, false, 0, 5, 4);
+        pool.emplace_back(3, 1, 10, false, 0, 5, 4);
+
+        Metrics metrics(pool);
+        int time = 0;
+        for (size_t idx = 0; idx < pool.size(); idx++)
+        {
+            pool[idx].recordFirstResponse(time);
+            while (pool[idx].getRemainingTime() > 0)
+            {
+                int ran = pool[idx].execute(4);
+                metrics.recordExecution(time, ran);
+                time += ran;
+            }
+            pool[idx].setCompletionTime(time);
+            metrics.recordCompletion(idx);
+
+            SystemMetrics live = metrics.snapshot(time);
+            assert_equal(live.completed_processes, static_cast<int>(idx + 1), " Live completions");
+            assert_true(live.cpu_utilization == 100.0, " CPU was busy the whole time");
+            assert_true(live.per_process.empty(), " Snapshot should not copy per process slots");
+        }
+
+        SystemMetrics live = metrics.snapshot(time);
+        assert_true(live.avg_turnaround_time == (4 + 10 + 20) / 3.0, " Live average turnaround");
+
+        const SystemMetrics& result = metrics.calculate(time);
+        assert_true(result.avg_turnaround_time == (4 + 10 + 20) / 3.0, " Average turnaround");
+        assert_true(result.avg_response_time == (0 + 4 + 10) / 3.0, " Average response");
+        assert_equal(result.per_process.size(), 3, " One slot per process");
+        assert_equal(result.per_process[2].completion_time, 20, " Slot should hold the completion");
+
+        // a second completion of the same process replaces the first one
+        pool[0].setCompletionTime(7);
+        metrics.recordCompletion(0);
+        assert_equal(metrics.snapshot(time).completed_processes, 3, " Counted once");
+        assert_true(metrics.calculate(time).avg_turnaround_time == (7 + 10 + 20) / 3.0,
+                    " Replaced completion should be in the average");
+
+        // a process that never completed still counts with its current values
+        std::vector<PCB> partial;
+        partial.emplace_back(1, 1, 4, false, 0, 5, 4);
+        partial.emplace_back(2, 1, 0, false, 0, 5, 4);
+        Metrics partial_metrics(partial);
+        partial[0].recordFirstResponse(2);
+        partial[0].setCompletionTime(6);
+        partial_metrics.recordCompletion(0);
+        const SystemMetrics& mixed = partial_metrics.calculate(6);
+        int never = partial[1].getFirstResponseTime();
+        assert_true(mixed.avg_response_time == (2 + never) / 2.0,
+                    " Uncompleted processes should be in the average");
+
+        // the scheduler's live view at the end matches the metrics file
+        std::string logfile = "incremental_metrics_test";
+        trackFile(extensionNDJSON(logfile));
+        trackFile(extensionJSON(logfile + "_metrics"));
+        Scheduler scheduler(logfile, config_path.string());
+        assert_equal(scheduler.getMetricsSnapshot().completed_processes, 0, " Nothing done yet");
+        scheduler.run();
+
+        SystemMetrics end = scheduler.getMetricsSnapshot();
+        json written = json::parse(std::ifstream(makeLogPath(logfile + "_metrics")))[0];
+        assert_equal(end.completed_processes, 3, " Every process should complete");
+        assert_true(end.avg_turnaround_time ==
+                        written["system_metrics"]["Average turnaround time"].get<double>(),
+                    " Snapshot should match the written metrics");
+    }
+};
+
+class ZeroBurstAgingTest : public TestFixture
+{
+   public:
+    ZeroBurstAgingTest() : TestFixture("Zero Burst Aging Test")
+    {
+    }
+
+    void test()
+    {
+        // a burst 0 process is never aged, P3 keeps priority 3 and P1 still finishes at 29.
+        std::string configfile = "zero_burst_config";
+        std::string logfile = "zero_burst_test";
+        trackFile(extensionJSON(configfile));
+        trackFile(logfile + ".trace");
+        trackFile(extensionJSON(logfile + "_metrics"));
+        {
+            std::ofstream out(makeLogPath(configfile));
+            out << R"({"scheduler_config": {"time_quantum": 2, "aging_threshold": 1,
+                                            "max_priority": 3, "context_switch_time": 1},
+                       "processes": [
+                           {"pid": 1, "priority": 1, "burst_time": 10, "io_bound": false,
+                            "io_interval": 0},
+                           {"pid": 2, "priority": 1, "burst_time": 10, "io_bound": false,
+                            "io_interval": 0},
+                           {"pid": 3, "priority": 3, "burst_time": 0, "io_bound": false,
+                            "io_interval": 0},
+                           {"pid": 4, "priority": 3, "burst_time": 4, "io_bound": false,
+                            "io_interval": 0}]})";
+        }
+
+        Scheduler scheduler(logfile, configfile, Scheduler::LogFormat::BINARY);
+        scheduler.run();
+        scheduler.flushLogs();
+
+        for (const auto& r : readTrace(makeTracePath(logfile)))
+        {
+            if (r.pid == 3)
+                assert_equal(r.prio, 3, " A burst 0 process should never be promoted");
+        }
+
+        // completion times of the scheduler before the aging engine
+        json written = json::parse(std::ifstream(makeLogPath(logfile + "_metrics")))[0];
+        std::map<int, int> completion;
+        for (const auto& pm : written["process_metrics"])
+            completion[pm["PID"].get<int>()] = pm["Completion time"].get<int>();
+        assert_equal(completion[1], 29, " P1 completion should match the old scheduler");
+        assert_equal(completion[2], 35, " P2 completion should match the old scheduler");
+        assert_equal(completion[4], 32, " P4 completion should match the old scheduler");
+        assert_equal(written["system_metrics"]["total time"].get<int>(), 35, " Total time");
     }
 };
 
@@ -113,6 +810,140 @@ void run_scheduler_tests()
         std::cout << "Exception raised in [FULL RUN TEST] with: " << e.what() << std::endl;
         failed++;
     }
+
+    try
+    {
+        EventCalendarOrderTest test4;
+        test4.run([&]() { test4.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [EVENT CALENDAR TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        NdjsonWriterTest test5;
+        test5.run([&]() { test5.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [NDJSON WRITER TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        BinaryTraceTest test6;
+        test6.run([&]() { test6.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [BINARY TRACE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        AsyncLogTest test7;
+        test7.run([&]() { test7.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [ASYNC LOG TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        LogMemoryCapTest test8;
+        test8.run([&]() { test8.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [LOG MEMORY CAP TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        MmapTraceTest test9;
+        test9.run([&]() { test9.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [MMAP TRACE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+    try
+    {
+        LogPolicyTest test10;
+        test10.run([&]() { test10.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [LOG POLICY TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        DebugSinkTest test11;
+        test11.run([&]() { test11.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [DEBUG SINK TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ChromeTraceTest test12;
+        test12.run([&]() { test12.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [CHROME TRACE TEST] with: " << e.what() << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        IncrementalMetricsTest test13;
+        test13.run([&]() { test13.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [INCREMENTAL METRICS TEST] with: " << e.what()
+                  << std::endl;
+        failed++;
+    }
+
+    try
+    {
+        ZeroBurstAgingTest test14;
+        test14.run([&]() { test14.test(); });
+        passed++;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception raised in [ZERO BURST AGING TEST] with: " << e.what()
+                  << std::endl;
+        failed++;
+    }
+
     std::cout << "Scheduler test passed with: " << passed << " passed , " << failed << " failed"
               << std::endl;
 }
\ No newline at end of file
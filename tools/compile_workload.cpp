@@ -0,0 +1,42 @@
+#include <filesystem>
+#include <iostream>
+
+#include "ConfigLoader.h"
+
+/*
+Validates a json process config and compiles it to a binary workload (Workload.h), which the
+scheduler memory maps instead of parsing the json.
+    compile-workload <in.json> [out.workload]
+*/
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <in.json> [out.workload]" << std::endl;
+        return 1;
+    }
+
+    // ConfigLoader resolves relative names against the log directory
+    std::filesystem::path in = std::filesystem::absolute(argv[1]);
+    std::filesystem::path out = argc > 2 ? std::filesystem::path(argv[2])
+                                         : std::filesystem::path(in).replace_extension(".workload");
+
+    try
+    {
+        ConfigLoader loader(in.string());
+        if (!loader.compileWorkload(out))
+        {
+            std::cerr << "Could not write " << out.string() << std::endl;
+            return 1;
+        }
+        std::cout << "Compiled " << loader.getProcessCount() << " processes to " << out.string()
+                  << " (" << std::filesystem::file_size(out) << " bytes)" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <iostream>
+
+#include "BinaryTrace.h"
+
+/*
+Converts a binary scheduler trace to the NDJSON event log layout.
+    trace2json <in.trace> [out.ndjson]
+*/
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <in.trace> [out.ndjson]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path in = argv[1];
+    std::filesystem::path out = argc > 2 ? std::filesystem::path(argv[2])
+                                         : std::filesystem::path(in).replace_extension(".ndjson");
+
+    try
+    {
+        size_t count = convertTraceToNdjson(in, out);
+        std::cout << "Converted " << count << " events to " << out.string() << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}